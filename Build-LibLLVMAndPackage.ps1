@@ -8,6 +8,28 @@ using module "PSModules/RepoBuild/RepoBuild.psd1"
 .PARAMETER Configuration
     This sets the build configuration to use, default is "Release" though for inner loop development this may be set to "Debug"
 
+.PARAMETER Flavor
+    Selects the flavor of library to build. 'Full' (the default) includes all targets and components. 'JitOnly' is a
+    reduced footprint library for the native target only without the assembly parsers (IR text and target assembly)
+    or disassemblers. The LLVM libraries for a flavor other than 'Full' are built into a distinct directory so that
+    both flavors can co-exist for comparison. (see: Measure-LibLLVMFootprint)
+
+.PARAMETER StartupProfile
+    Builds the LibLLVM library with startup profiling enabled. This records the time spent in the static initializers
+    of the library when it is loaded so that it is available from LibLLVMGetStartupProfile(). This is intended for
+    measurement of load/cold start times and is not normally enabled for a release.
+
+.PARAMETER LtoPgo
+    Builds LLVM and the LibLLVM library with link time code generation and then optimizes the library with profile
+    guided optimization. This first builds an instrumented library, runs the LibLLVMWorkload on it to collect the
+    profile and then re-links the library using the profile. The LLVM libraries for this build are built into a
+    distinct directory so that they co-exist with a normal build for comparison. (see: Compare-LibLLVMWorkload)
+    [Windows only]
+
+.PARAMETER Benchmarks
+    Builds the Google Benchmark library along with LLVM and the LibLLVMBenchmarks micro benchmarks of the extended C
+    API. The benchmarks are built but not run. [Windows only]
+
 .PARAMETER FullInit
     Performs a full initialization. A full initialization includes forcing a re-capture of the time stamp for local builds
     as well as writes details of the initialization to the information and verbose streams.
@@ -24,7 +46,12 @@ Param(
     [ValidateSet('Release','Debug')]
     [string]$Configuration="Release",
     [switch]$FullInit,
-    [switch]$SkipLLvm
+    [switch]$SkipLLvm,
+    [switch]$StartupProfile,
+    [switch]$LtoPgo,
+    [switch]$Benchmarks,
+    [ValidateSet('Full','JitOnly')]
+    [string]$Flavor = 'Full'
 )
 
 Set-StrictMode -Version 3.0
@@ -41,6 +68,19 @@ try
 
     $currentRid = [System.Runtime.InteropServices.RuntimeInformation]::RuntimeIdentifier
 
+    # Components excluded from each flavor of the library; MUST be names known to the LlvmBindingsGenerator
+    $flavorExcludedComponents = @{
+        Full = @()
+        JitOnly = @('AsmParser', 'Disassembler')
+    }
+
+    $excludedComponents = $flavorExcludedComponents[$Flavor]
+
+    # Builds of LLVM other than the default go to a distinct directory so that they co-exist
+    $configSuffix = @($Flavor -eq 'Full' ? $null : $Flavor) + @($LtoPgo ? 'LtoPgo' : $null) | ?{ $_ }
+    $configSuffix = $configSuffix ? "-$($configSuffix -join '-')" : ''
+    $llvmConfigName = "$currentRid$configSuffix"
+
     # inner loop optimization (shaves time off build if already done)
     # Most common inner loop work is with the extended API and final DLL
     # not with LLVM itself, so this keeps the loop short.
@@ -57,9 +97,16 @@ try
         # Verify CMake version info (Official minimum for LLVM as of 20.1.3)
         Assert-CmakeInfo ([Version]::new(3, 20, 0))
 
-        $cmakeConfig = New-LlvmCMakeConfig -AllTargets -Name $currentRid -BuildConfig $Configuration -BuildInfo $buildInfo
+        $cmakeConfig = New-LlvmCMakeConfig -AllTargets:($Flavor -eq 'Full') -Ltcg:$LtoPgo -Benchmarks:$Benchmarks -Name $llvmConfigName -BuildConfig $Configuration -BuildInfo $buildInfo
         Generate-CMakeConfig $cmakeConfig
-        Build-CmakeConfig $cmakeConfig @('lib/all')
+
+        $llvmBuildTargets = @('lib/all')
+        if ($Benchmarks)
+        {
+            $llvmBuildTargets += 'benchmark'
+        }
+
+        Build-CmakeConfig $cmakeConfig $llvmBuildTargets
 
         # Notify size of build output directory as that's a BIG player in total space used in an
         # automated build scenario. (OSS build systems often limit space so it's important to know)
@@ -73,7 +120,7 @@ try
         #TODO: generalize this for ALL windows architectures (ARM64...)
         # SEE: Llvm-Libs.props in the root of this repo for how this is specified for
         # the C++ build.
-        $llvmPlatformConfig = "win-x64"
+        $llvmPlatformConfig = "win-x64$configSuffix"
 
         $llvmPlatformConfigRoot = Join-Path $buildInfo['BuildOutputPath'] $llvmPlatformConfig
         $extensionsRoot = Join-Path $buildInfo['SrcRootPath'] 'LibLLVM'
@@ -82,6 +129,7 @@ try
             ExtensionsRoot = $extensionsRoot
             ConfigPathRoot = $llvmPlatformConfigRoot
             ExportsDefFilePath = Join-Path $extensionsRoot 'exports.g.def'
+            ExcludedComponents = $excludedComponents
         }
 
         # run the generator so the output is available to the DLL generation
@@ -115,12 +163,59 @@ try
         $libLLvmBuildProps = @{ Configuration = $Configuration
                                 LlvmVersion = Get-LlvmVersionString $buildInfo
                                 RuntimeIdentifier = $currentRid
+                                LibLLVMStartupProfile = $StartupProfile.IsPresent
                               }
+
+        if ($configSuffix)
+        {
+            $libLLvmBuildProps['LlvmPlatformConfig'] = $llvmPlatformConfig
+        }
+
+        if ($Flavor -ne 'Full')
+        {
+            $libLLvmBuildProps['LlvmTargetsToBuild'] = Get-NativeTarget
+            # NOTE: property list is semicolon delimited so the list of components uses the MSBuild escaped form
+            $libLLvmBuildProps['LibLLVMExcludedComponents'] = $excludedComponents -join '%3B'
+        }
+
+        if ($LtoPgo)
+        {
+            # Build an instrumented library and the workload that uses it to generate the profile
+            $instrumentPropList = ConvertTo-PropertyList ($libLLvmBuildProps + @{ LibLLVMPgoPhase = 'Instrument' })
+
+            Write-Information "Building instrumented LibLLVM"
+            $instrumentBinLogPath = Join-Path $buildInfo['BinLogsPath'] "LibLLVM-Instrument-$currentRid.binlog"
+            Invoke-external MSBuild '-t:Build' "-p:$instrumentPropList" "-bl:$instrumentBinLogPath" '-v:m' $libLLVMVcxProj
+
+            $workloadVcxProj = Join-Path 'src' 'LibLLVMWorkload' 'LibLLVMWorkload.vcxproj'
+            $workloadBinLogPath = Join-Path $buildInfo['BinLogsPath'] "LibLLVMWorkload-$currentRid.binlog"
+            Invoke-external MSBuild '-t:Build' "-p:$instrumentPropList" "-bl:$workloadBinLogPath" '-v:m' $workloadVcxProj
+
+            # Run the workload to generate the profile (*.pgc) files next to the instrumented library; The
+            # instrumented library requires the PGO runtime from the VC tools, which is on the path of the
+            # developer environment this script runs in.
+            Write-Information "Collecting profile for LibLLVM"
+            $libLLVMBinPath = Join-Path $buildInfo['BuildOutputPath'] 'bin' 'LibLLVM' $currentRid
+            $env:Path = "$libLLVMBinPath$([System.IO.Path]::PathSeparator)$env:Path"
+            Invoke-External (Join-Path $buildInfo['BuildOutputPath'] 'bin' 'LibLLVMWorkload' $currentRid 'LibLLVMWorkload.exe')
+            $env:Path = $oldPath
+
+            $libLLvmBuildProps['LibLLVMPgoPhase'] = 'Optimize'
+        }
+
         $libLlvmBuildPropList = ConvertTo-PropertyList $libLLvmBuildProps
 
         Write-Information "Building LibLLVM"
         $libLLVMBinLogPath = Join-Path $buildInfo['BinLogsPath'] "LibLLVM-Build-$currentRid.binlog"
         Invoke-external MSBuild '-t:Build' "-p:$libLlvmBuildPropList" "-bl:$libLLVMBinLogPath" '-v:m' $libLLVMVcxProj
+
+        if ($Benchmarks)
+        {
+            Write-Information "Building LibLLVMBenchmarks"
+            $benchmarksVcxProj = Join-Path 'src' 'LibLLVMBenchmarks' 'LibLLVMBenchmarks.vcxproj'
+            $benchmarksBinLogPath = Join-Path $buildInfo['BinLogsPath'] "LibLLVMBenchmarks-$currentRid.binlog"
+            Invoke-external MSBuild '-t:Build' "-p:$libLlvmBuildPropList" "-bl:$benchmarksBinLogPath" '-v:m' $benchmarksVcxProj
+        }
     }
 
     # Build NuGetPackage for the target library
@@ -0,0 +1,94 @@
+function Compare-LibLLVMWorkload
+{
+<#
+.SYNOPSIS
+    Compares the performance of builds of the LibLLVM library using the representative workload
+
+.PARAMETER Workload
+    Path of the LibLLVMWorkload executable
+
+.PARAMETER Baseline
+    Path of the library to use as the baseline for comparison (normally the default build)
+
+.PARAMETER Candidate
+    Path(s) of the libraries to compare against the baseline (i.e. the LTCG+PGO build)
+
+.PARAMETER Runs
+    Number of times to run the workload for each library; The median time of each stage is reported.
+
+.PARAMETER WorkloadArgs
+    Additional arguments for the workload (i.e. @('--iterations', '20', '--functions', '100'))
+
+.DESCRIPTION
+    The workload and each library are copied to a distinct temporary folder so that the library the
+    workload binds to is unambiguous. The output includes the median time of each stage and the percentage
+    change of the total time relative to the baseline; negative is faster.
+#>
+    [OutputType([PSCustomObject])]
+    param(
+        [Parameter(Mandatory=$true)]
+        [string]$Workload,
+        [Parameter(Mandatory=$true)]
+        [string]$Baseline,
+        [Parameter(Mandatory=$true)]
+        [string[]]$Candidate,
+        [ValidateRange(1, 100)]
+        [int]$Runs = 5,
+        [string[]]$WorkloadArgs = @()
+    )
+
+    $baselineTotal = $null
+    foreach($libPath in @($Baseline) + $Candidate)
+    {
+        $fullPath = (Resolve-Path $libPath).Path
+        $runDir = Join-Path ([System.IO.Path]::GetTempPath()) "LibLLVMWorkload-$([System.Guid]::NewGuid().ToString('N'))"
+        New-Item -ItemType Directory $runDir | Out-Null
+        try
+        {
+            Copy-Item $Workload $runDir
+            Copy-Item $fullPath $runDir
+            $exePath = Join-Path $runDir (Split-Path -Leaf $Workload)
+
+            # collect the times of every run for each stage
+            $stageTimes = [ordered]@{}
+            for($i = 0; $i -lt $Runs; ++$i)
+            {
+                $output = & $exePath @WorkloadArgs
+                if ($LASTEXITCODE -ne 0)
+                {
+                    throw "Workload failed for '$fullPath' with exit code $LASTEXITCODE"
+                }
+
+                foreach($line in $output)
+                {
+                    $stage, $ms = $line -split "`t"
+                    if (!$stageTimes.Contains($stage))
+                    {
+                        $stageTimes[$stage] = [System.Collections.ArrayList]@()
+                    }
+
+                    $stageTimes[$stage].Add([double]$ms) | Out-Null
+                }
+            }
+
+            $result = [ordered]@{ Path = $fullPath }
+            foreach($stage in $stageTimes.GetEnumerator())
+            {
+                $sorted = @($stage.Value | Sort-Object)
+                $result["$($stage.Key)Ms"] = [math]::Round($sorted[[int][math]::Floor($sorted.Count / 2)], 3)
+            }
+
+            if ($null -eq $baselineTotal)
+            {
+                $baselineTotal = $result['TotalMs']
+            }
+
+            $result['TotalDeltaPercent'] = [math]::Round((($result['TotalMs'] - $baselineTotal) * 100.0) / $baselineTotal, 2)
+            Write-Output ([PSCustomObject]$result)
+        }
+        finally
+        {
+            Remove-Item -Recurse -Force $runDir -ErrorAction SilentlyContinue
+        }
+    }
+}
@@ -44,6 +44,12 @@ function Invoke-BindingsGenerator([hashtable]$buildInfo , [hashtable]$Options)
         $generatorArgs.AddRange(@('-d', $Options['ExportsDefFilePath']))
     }
 
+    # Optional set of components to exclude from the exports for a reduced footprint library
+    if ($Options.ContainsKey('ExcludedComponents') -and $Options['ExcludedComponents'])
+    {
+        $generatorArgs.AddRange(@('-x', ($Options['ExcludedComponents'] -join ';')))
+    }
+
     Write-Information "dotnet $($generatorArgs -join ' ')"
     # NOTE: using array and splatting args to handle optional args and due to various parsing issues with parameters
     # [see](https://github.com/PowerShell/PowerShell/issues?q=is%3Aissue+in%3Atitle+argument-parsing)
@@ -0,0 +1,58 @@
+function Measure-LibLLVMFootprint
+{
+<#
+.SYNOPSIS
+    Reports the binary size and load time of one or more builds of the LibLLVM library
+
+.PARAMETER Baseline
+    Path of the library to use as the baseline for comparison (normally the 'Full' flavor)
+
+.PARAMETER Candidate
+    Path(s) of the libraries to compare against the baseline (i.e. the 'JitOnly' flavor)
+
+.PARAMETER Iterations
+    Number of times to load each library; The median of the load times is reported.
+
+.DESCRIPTION
+    Each load is done in a new process so that it includes the full cost of mapping the library and running
+    all of its static initializers, as it would for the first use in an application. The OS file cache is
+    NOT flushed so the times reflect a "warm" start from the file system.
+#>
+    [OutputType([PSCustomObject])]
+    param(
+        [Parameter(Mandatory=$true)]
+        [string]$Baseline,
+        [Parameter(Mandatory=$true)]
+        [string[]]$Candidate,
+        [ValidateRange(1, 1000)]
+        [int]$Iterations = 10
+    )
+
+    $baselineInfo = $null
+    foreach($libPath in @($Baseline) + $Candidate)
+    {
+        $fullPath = (Resolve-Path $libPath).Path
+        $loadScript = "`$sw = [System.Diagnostics.Stopwatch]::StartNew(); [System.Runtime.InteropServices.NativeLibrary]::Load('$fullPath') | Out-Null; `$sw.Stop(); `$sw.Elapsed.TotalMilliseconds"
+
+        $loadTimes = @(1..$Iterations | %{ [double](pwsh -NoProfile -NonInteractive -Command $loadScript) } | Sort-Object)
+        $info = [PSCustomObject]@{
+            Path = $fullPath
+            SizeBytes = (Get-Item $fullPath).Length
+            MedianLoadMs = [math]::Round($loadTimes[[int][math]::Floor($loadTimes.Count / 2)], 3)
+            SizeDeltaPercent = 0.0
+            LoadDeltaPercent = 0.0
+        }
+
+        if($baselineInfo)
+        {
+            $info.SizeDeltaPercent = [math]::Round((($info.SizeBytes - $baselineInfo.SizeBytes) * 100.0) / $baselineInfo.SizeBytes, 2)
+            $info.LoadDeltaPercent = [math]::Round((($info.MedianLoadMs - $baselineInfo.MedianLoadMs) * 100.0) / $baselineInfo.MedianLoadMs, 2)
+        }
+        else
+        {
+            $baselineInfo = $info
+        }
+
+        Write-Output $info
+    }
+}
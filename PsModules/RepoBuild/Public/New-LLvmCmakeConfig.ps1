@@ -8,7 +8,9 @@ function New-LlvmCmakeConfig
         [string]$buildConfig,
         [hashtable]$buildInfo,
         [string]$cmakeSrcRoot = $buildInfo['LlvmRoot'],
-        [switch]$AllTargets
+        [switch]$AllTargets,
+        [switch]$Ltcg,
+        [switch]$Benchmarks
     )
 
     $cmakeConfig = New-CMakeConfig $name $buildConfig $buildInfo $cmakeSrcRoot
@@ -32,9 +34,31 @@ function New-LlvmCmakeConfig
     $buildVars['LLVM_INCLUDE_TESTS'] = 'OFF'
     $buildVars['LLVM_INCLUDE_TOOLS'] = 'OFF'
     $buildVars['LLVM_INCLUDE_UTILS'] = 'OFF'
-    $buildVars['LLVM_TARGETS_TO_BUILD']  = $AllTargets ? 'all' : '$(Get-NativeTarget);$additionalTarget'
+    $buildVars['LLVM_TARGETS_TO_BUILD']  = $AllTargets ? 'all' : (@(Get-NativeTarget) + @($additionalTarget) | ?{ $_ }) -join ';'
     $buildVars['LLVM_ADD_NATIVE_VISUALIZERS_TO_SOLUTION'] = 'ON'
 
+    # Link time code generation of the static libraries so the final LibLLVM link can optimize (and apply PGO)
+    # across the entire library. This is the MSVC equivalent of LTO; The libraries are significantly larger and
+    # the final link is much slower so this is only used for an optimized build of the library.
+    if ($Ltcg)
+    {
+        if (!$IsWindows)
+        {
+            throw "Link time code generation is only supported for Windows (MSVC) builds"
+        }
+
+        # For MSVC this compiles with /GL and creates the static libraries with /LTCG
+        $buildVars['CMAKE_INTERPROCEDURAL_OPTIMIZATION'] = 'ON'
+    }
+
+    # Include the Google Benchmark library from the LLVM source tree so that it is built with the same
+    # compiler and options as LLVM for use by the LibLLVMBenchmarks. (Build target 'benchmark') The
+    # benchmarks of LLVM itself are NOT built as LLVM_BUILD_BENCHMARKS remains OFF.
+    if ($Benchmarks)
+    {
+        $buildVars['LLVM_INCLUDE_BENCHMARKS'] = 'ON'
+    }
+
     #if ($IsWindows)
     #{
     #    $buildVars['LLVM_ENABLE_PDB'] = 'ON'
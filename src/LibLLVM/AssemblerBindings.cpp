@@ -0,0 +1,311 @@
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "libllvm-c/AssemblerBindings.h"
+#include "libllvm-c/TargetRegistrationBindings.h"
+#include <llvm/ADT/Sequence.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/MC/MCAsmBackend.h>
+#include <llvm/MC/MCAsmInfo.h>
+#include <llvm/MC/MCCodeEmitter.h>
+#include <llvm/MC/MCContext.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCObjectFileInfo.h>
+#include <llvm/MC/MCObjectWriter.h>
+#include <llvm/MC/MCParser/MCAsmParser.h>
+#include <llvm/MC/MCParser/MCTargetAsmParser.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCStreamer.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/MCTargetOptions.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Parallel.h>
+#include <llvm/Support/SmallVectorMemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/TargetParser/Triple.h>
+
+using namespace llvm;
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMAssemblySnippet>, "LibLLVMAssemblySnippet must be blittable for stable ABI binding");
+
+    // The target descriptions are created once and shared; The asm parser does not modify the subtarget
+    // info (directives that change it, like .arch, work on a copy owned by the MCContext) so each
+    // assembly only needs its own MCContext, streamer and parser.
+    class Assembler
+    {
+    public:
+        Triple TargetTriple;
+        Target const* TheTarget = nullptr;
+        MCTargetOptions Options;
+        std::unique_ptr<MCRegisterInfo const> MRI;
+        std::unique_ptr<MCAsmInfo const> MAI;
+        std::unique_ptr<MCSubtargetInfo const> STI;
+        std::unique_ptr<MCInstrInfo const> MII;
+
+        Expected<std::unique_ptr<MemoryBuffer>> Assemble(StringRef name, StringRef text) const
+        {
+            // Capture all diagnostics (from the parser and the context) instead of printing them
+            std::string diagnostics;
+            raw_string_ostream diagStream(diagnostics);
+            auto handler = [&](SMDiagnostic const& diag)
+                {
+                    diag.print(nullptr, diagStream, /*ShowColors*/ false);
+                };
+
+            SourceMgr srcMgr;
+            srcMgr.setDiagHandler([](SMDiagnostic const& diag, void* context)
+                {
+                    (*static_cast<decltype(handler)*>(context))(diag);
+                }, &handler);
+
+            // The lexer relies on a nul terminator at the end of the buffer and the caller's text is not required
+            // to have one, so the text is copied into a terminated buffer.
+            srcMgr.AddNewSourceBuffer(MemoryBuffer::getMemBufferCopy(text, name), SMLoc());
+
+            MCContext ctx(TargetTriple, MAI.get(), MRI.get(), STI.get(), &srcMgr, &Options);
+            ctx.setDiagnosticHandler([&](SMDiagnostic const& diag, bool, SourceMgr const&, std::vector<MDNode const*>&)
+                {
+                    handler(diag);
+                });
+
+            std::unique_ptr<MCObjectFileInfo> mofi(TheTarget->createMCObjectFileInfo(ctx, /*PIC*/ false));
+            ctx.setObjectFileInfo(mofi.get());
+
+            SmallVector<char, 0> objBuffer;
+            raw_svector_ostream objStream(objBuffer);
+
+            std::unique_ptr<MCCodeEmitter> emitter(TheTarget->createMCCodeEmitter(*MII, ctx));
+            std::unique_ptr<MCAsmBackend> backend(TheTarget->createMCAsmBackend(*STI, *MRI, Options));
+            if (!emitter || !backend)
+            {
+                return createStringError(inconvertibleErrorCode(), "Unable to create a code emitter or asm backend for the target; is the target machine registered?");
+            }
+
+            std::unique_ptr<MCObjectWriter> writer = backend->createObjectWriter(objStream);
+            std::unique_ptr<MCStreamer> streamer(TheTarget->createMCObjectStreamer(TargetTriple
+                                                                                   , ctx
+                                                                                   , std::move(backend)
+                                                                                   , std::move(writer)
+                                                                                   , std::move(emitter)
+                                                                                   , *STI
+                                                                                   ));
+
+            std::unique_ptr<MCAsmParser> parser(createMCAsmParser(srcMgr, ctx, *streamer, *MAI));
+            std::unique_ptr<MCTargetAsmParser> targetParser(TheTarget->createMCAsmParser(*STI, *parser, *MII, Options));
+            if (!targetParser)
+            {
+                return createStringError(inconvertibleErrorCode(), "Unable to create an asm parser for the target; is the AsmParser registered?");
+            }
+
+            parser->setTargetParser(*targetParser);
+
+            // Run() finishes the streamer, which writes the object, only if there are no errors
+            if (parser->Run(/*NoInitialTextSection*/ false) || ctx.hadError())
+            {
+                diagStream.flush();
+                std::string message = StringRef(diagnostics).rtrim().str();
+                return createStringError(inconvertibleErrorCode(), message.empty() ? "Assembly failed" : message.c_str());
+            }
+
+            return std::make_unique<SmallVectorMemoryBuffer>(std::move(objBuffer), name, /*RequiresNullTerminator*/ false);
+        }
+    };
+
+    Expected<std::unique_ptr<Assembler>> CreateAssembler(StringRef triple, StringRef cpu, StringRef features)
+    {
+        if (triple.empty())
+        {
+            return createStringError(inconvertibleErrorCode(), "triple is null or empty");
+        }
+
+        // Complete a lazy registration of the asm parser; an unknown target is reported by the lookup
+        LLVMConsumeError(LibLLVMRegisterPendingTargetForTriple(triple.data(), triple.size(), TargetRegistration_AsmParser));
+
+        std::string errMsg;
+        Target const* target = TargetRegistry::lookupTarget(triple.str(), errMsg);
+        if (target == nullptr)
+        {
+            return createStringError(inconvertibleErrorCode(), errMsg.c_str());
+        }
+
+        auto retVal = std::make_unique<Assembler>();
+        retVal->TargetTriple = Triple(triple);
+        retVal->TheTarget = target;
+        retVal->MRI.reset(target->createMCRegInfo(triple));
+        if (!retVal->MRI)
+        {
+            return createStringError(inconvertibleErrorCode(), "Unable to create register info for the target");
+        }
+
+        retVal->MAI.reset(target->createMCAsmInfo(*retVal->MRI, triple, retVal->Options));
+        if (!retVal->MAI)
+        {
+            return createStringError(inconvertibleErrorCode(), "Unable to create asm info for the target");
+        }
+
+        retVal->STI.reset(target->createMCSubtargetInfo(triple, cpu, features));
+        if (!retVal->STI)
+        {
+            return createStringError(inconvertibleErrorCode(), "Unable to create subtarget info for the target");
+        }
+
+        retVal->MII.reset(target->createMCInstrInfo());
+        if (!retVal->MII)
+        {
+            return createStringError(inconvertibleErrorCode(), "Unable to create instruction info for the target");
+        }
+
+        return std::move(retVal);
+    }
+
+    inline StringRef GetStringRef(char const* str, size_t len)
+    {
+        return str == nullptr ? StringRef() : StringRef(str, len);
+    }
+
+    inline Assembler* unwrap(LibLLVMAssemblerRef assembler)
+    {
+        return reinterpret_cast<Assembler*>(assembler);
+    }
+
+    inline LibLLVMAssemblerRef wrap(Assembler* assembler)
+    {
+        return reinterpret_cast<LibLLVMAssemblerRef>(assembler);
+    }
+}
+
+extern "C"
+{
+    LLVMErrorRef LibLLVMCreateAssembler( char const* triple
+                                       , size_t tripleLen
+                                       , char const* cpu
+                                       , size_t cpuLen
+                                       , char const* features
+                                       , size_t featuresLen
+                                       , LibLLVMAssemblerRef* outRetVal
+                                       )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        Expected<std::unique_ptr<Assembler>> assembler = CreateAssembler(GetStringRef(triple, tripleLen), GetStringRef(cpu, cpuLen), GetStringRef(features, featuresLen));
+        if (!assembler)
+        {
+            return wrap(assembler.takeError());
+        }
+
+        *outRetVal = wrap(assembler->release());
+        return nullptr;
+    }
+
+    void LibLLVMDisposeAssembler( LibLLVMAssemblerRef assembler )
+    {
+        delete unwrap(assembler);
+    }
+
+    LLVMErrorRef LibLLVMAssemblerAssemble( LibLLVMAssemblerRef assembler
+                                         , char const* text
+                                         , size_t textLen
+                                         , LLVMMemoryBufferRef* outObject
+                                         )
+    {
+        if (outObject == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outObject' is null!");
+        }
+
+        *outObject = nullptr;
+        Expected<std::unique_ptr<MemoryBuffer>> obj = unwrap(assembler)->Assemble("<asm>", GetStringRef(text, textLen));
+        if (!obj)
+        {
+            return wrap(obj.takeError());
+        }
+
+        *outObject = wrap(obj->release());
+        return nullptr;
+    }
+
+    LLVMErrorRef LibLLVMAssembleToObject( char const* triple
+                                        , size_t tripleLen
+                                        , char const* cpu
+                                        , size_t cpuLen
+                                        , char const* features
+                                        , size_t featuresLen
+                                        , char const* text
+                                        , size_t textLen
+                                        , LLVMMemoryBufferRef* outObject
+                                        )
+    {
+        if (outObject == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outObject' is null!");
+        }
+
+        *outObject = nullptr;
+        Expected<std::unique_ptr<Assembler>> assembler = CreateAssembler(GetStringRef(triple, tripleLen), GetStringRef(cpu, cpuLen), GetStringRef(features, featuresLen));
+        if (!assembler)
+        {
+            return wrap(assembler.takeError());
+        }
+
+        return LibLLVMAssemblerAssemble(wrap(assembler->get()), text, textLen, outObject);
+    }
+
+    LLVMErrorRef LibLLVMAssembleBatch( LibLLVMAssemblerRef assembler
+                                     , LibLLVMAssemblySnippet const* snippets
+                                     , size_t numSnippets
+                                     , LLVMMemoryBufferRef* outObjects
+                                     )
+    {
+        if (outObjects == nullptr && numSnippets > 0)
+        {
+            return LLVMCreateStringError("Out parameter 'outObjects' is null!");
+        }
+
+        if (snippets == nullptr && numSnippets > 0)
+        {
+            return LLVMCreateStringError("snippets is null");
+        }
+
+        Assembler const& self = *unwrap(assembler);
+        std::vector<std::unique_ptr<MemoryBuffer>> objects(numSnippets);
+        Error err = parallelForEachError(seq<size_t>(0, numSnippets), [&](size_t i) -> Error
+            {
+                LibLLVMAssemblySnippet const& snippet = snippets[i];
+                StringRef name = GetStringRef(snippet.Name, snippet.NameLen);
+                std::string defaultName;
+                if (name.empty())
+                {
+                    defaultName = "<snippet " + std::to_string(i) + ">";
+                    name = defaultName;
+                }
+
+                Expected<std::unique_ptr<MemoryBuffer>> obj = self.Assemble(name, GetStringRef(snippet.Text, snippet.TextLen));
+                if (!obj)
+                {
+                    return obj.takeError();
+                }
+
+                objects[i] = std::move(*obj);
+                return Error::success();
+            });
+
+        // all or nothing; any objects that did succeed are released with the vector on failure
+        for (size_t i = 0; i < numSnippets; ++i)
+        {
+            outObjects[i] = err ? nullptr : wrap(objects[i].release());
+        }
+
+        return err ? wrap(std::move(err)) : nullptr;
+    }
+}
@@ -1,11 +1,19 @@
 #include <type_traits>
 #include <array>
 #include <string_view>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <utility>
 
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Value.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/CBindingWrapping.h"
 #include "llvm-c/Error.h"
 #include "libllvm-c/AttributeBindings.h"
@@ -32,6 +40,558 @@ namespace
         pRetVal[strRef.size()] = '\0';
         return strncpy(pRetVal, strRef.data(), strRef.size());
     }
+
+    STDEX_DECLARE_ENUM_FLAGS(LibLLVMAttributeAllowedOn);
+
+    constexpr LibLLVMAttributeAllowedOn AllowedOnAll
+        = LibLLVMAttributeAllowedOn_Return
+        | LibLLVMAttributeAllowedOn_Parameter
+        | LibLLVMAttributeAllowedOn_Function
+        | LibLLVMAttributeAllowedOn_CallSite
+        | LibLLVMAttributeAllowedOn_Global;
+
+    struct AttributeKindName
+    {
+        Attribute::AttrKind Kind;
+        std::string_view Name;
+    };
+
+    // Names of all enumerated attributes indexed by the AttrKind; [0] is Attribute::None,
+    // which is used for ALL string attributes, so it has no name.
+    constexpr std::array EnumAttributeNames = {
+        AttributeKindName{Attribute::None, std::string_view()},
+#define GET_ATTR_NAMES
+#define ATTRIBUTE_ENUM(ENUM_NAME, DISPLAY_NAME) AttributeKindName{Attribute::ENUM_NAME, std::string_view(#DISPLAY_NAME)},
+#include "llvm/IR/Attributes.inc"
+#undef ATTRIBUTE_ENUM
+#undef ATTRIBUTE_ALL
+#undef GET_ATTR_NAMES
+    };
+
+    constexpr bool IsIndexedByKind(decltype(EnumAttributeNames) const& names)
+    {
+        for(size_t i = 0; i < names.size(); ++i)
+        {
+            if(static_cast<size_t>(names[i].Kind) != i)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(IsIndexedByKind(EnumAttributeNames), "Attribute names must be in the same order as the AttrKind enumeration");
+    static_assert(EnumAttributeNames.size() == static_cast<size_t>(Attribute::EndAttrKinds), "Attribute names must include ALL enumerated kinds");
+
+    LibLLVMAttributeInfo MakeAttributeInfo(Attribute::AttrKind attribKind)
+    {
+        LibLLVMAttributeInfo info = {};
+        info.ID = static_cast<unsigned>(attribKind);
+        if (attribKind == Attribute::None)
+        {
+            // It's string attribute (No ID), there's currently no way to determine
+            // if a given string value is valid on any particular "index"
+            // String attributes have no Enum ID either...
+            info.ArgKind = LibLLVMAttributeArgKind_String;
+            info.AllowedOn = AllowedOnAll;
+            return info;
+        }
+
+        // Enum attributes can have additional checks applied so provide details on that
+
+        if (Attribute::isEnumAttrKind(attribKind))
+        {
+            info.ArgKind = LibLLVMAttributeArgKind_None;
+        }
+        else if (Attribute::isIntAttrKind(attribKind))
+        {
+            info.ArgKind = LibLLVMAttributeArgKind_Int;
+        }
+        else if (Attribute::isTypeAttrKind(attribKind))
+        {
+            info.ArgKind = LibLLVMAttributeArgKind_Type;
+        }
+        else if (Attribute::isConstantRangeAttrKind(attribKind))
+        {
+            info.ArgKind = LibLLVMAttributeArgKind_ConstantRange;
+        }
+        else if (Attribute::isConstantRangeListAttrKind(attribKind))
+        {
+            info.ArgKind = LibLLVMAttributeArgKind_ConstantRangeList;
+        }
+        else
+        {
+            info.ArgKind = LibLLVMAttributeArgKind_None;
+        }
+
+        info.AllowedOn = LibLLVMAttributeAllowedOn_None;
+        if (Attribute::canUseAsFnAttr(attribKind))
+        {
+            info.AllowedOn |= LibLLVMAttributeAllowedOn_Function;
+        }
+
+        if (Attribute::canUseAsParamAttr(attribKind))
+        {
+            info.AllowedOn |= LibLLVMAttributeAllowedOn_Parameter;
+        }
+
+        if (Attribute::canUseAsRetAttr(attribKind))
+        {
+            info.AllowedOn |= LibLLVMAttributeAllowedOn_Return;
+        }
+
+        return info;
+    }
+
+    using AttributeInfoTable = std::array<LibLLVMAttributeTableEntry, EnumAttributeNames.size()>;
+
+    // The names are compile time constants, but the allowed usage is only available at runtime
+    // so the table is built once on first use. (Thread safe initialization of a function static)
+    AttributeInfoTable const& GetAttributeInfoTable()
+    {
+        static AttributeInfoTable const table = []()
+        {
+            AttributeInfoTable retVal = {};
+            for(size_t i = 0; i < EnumAttributeNames.size(); ++i)
+            {
+                std::string_view name = EnumAttributeNames[i].Name;
+                retVal[i].Name = name.empty() ? nullptr : name.data();
+                retVal[i].NameLen = name.size();
+                retVal[i].Info = MakeAttributeInfo(EnumAttributeNames[i].Kind);
+            }
+
+            return retVal;
+        }();
+
+        return table;
+    }
+
+    bool TryGetAttributes(Value* pValue, AttributeList& attributes)
+    {
+        if (auto* pFunc = dyn_cast<Function>(pValue))
+        {
+            attributes = pFunc->getAttributes();
+            return true;
+        }
+
+        if (auto* pCall = dyn_cast<CallBase>(pValue))
+        {
+            attributes = pCall->getAttributes();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool IsAllowedAt(Attribute attrib, unsigned index)
+    {
+        // String attributes have no restrictions on the index
+        if (attrib.isStringAttribute())
+        {
+            return true;
+        }
+
+        LibLLVMAttributeAllowedOn allowedOn = GetAttributeInfoTable()[attrib.getKindAsEnum()].Info.AllowedOn;
+        switch (index)
+        {
+        case AttributeList::FunctionIndex:
+            return (allowedOn & LibLLVMAttributeAllowedOn_Function) != LibLLVMAttributeAllowedOn_None;
+
+        case AttributeList::ReturnIndex:
+            return (allowedOn & LibLLVMAttributeAllowedOn_Return) != LibLLVMAttributeAllowedOn_None;
+
+        default:
+            return (allowedOn & LibLLVMAttributeAllowedOn_Parameter) != LibLLVMAttributeAllowedOn_None;
+        }
+    }
+
+    LLVMErrorRef MakeAttribute(LLVMContext& context, LibLLVMAttributeRecord const& record, Attribute& attrib)
+    {
+        if (record.AttributeRef != nullptr)
+        {
+            attrib = unwrap(record.AttributeRef);
+            return nullptr;
+        }
+
+        if (record.ID >= static_cast<uint32_t>(Attribute::EndAttrKinds))
+        {
+            return LLVMCreateStringError("Attribute record has an invalid ID");
+        }
+
+        auto kind = static_cast<Attribute::AttrKind>(record.ID);
+        switch (GetAttributeInfoTable()[record.ID].Info.ArgKind)
+        {
+        case LibLLVMAttributeArgKind_String:
+            if (record.StringKind == nullptr || record.StringKindLen == 0)
+            {
+                return LLVMCreateStringError("String attribute record has a null or empty kind");
+            }
+
+            attrib = Attribute::get(context, StringRef(record.StringKind, record.StringKindLen), StringRef(record.StringValue, record.StringValueLen));
+            return nullptr;
+
+        case LibLLVMAttributeArgKind_Int:
+            attrib = Attribute::get(context, kind, record.IntValue);
+            return nullptr;
+
+        case LibLLVMAttributeArgKind_Type:
+            if (record.TypeValue == nullptr)
+            {
+                return LLVMCreateStringError("Type attribute record has a null type");
+            }
+
+            attrib = Attribute::get(context, kind, unwrap(record.TypeValue));
+            return nullptr;
+
+        case LibLLVMAttributeArgKind_None:
+            attrib = Attribute::get(context, kind);
+            return nullptr;
+
+        default:
+            return LLVMCreateStringError("Constant range attribute records require an AttributeRef");
+        }
+    }
+
+    LLVMErrorRef BuildAttributeList( LLVMContext& context
+                                   , unsigned numArgs
+                                   , LibLLVMAttributeRecord const* records
+                                   , size_t numRecords
+                                   , AttributeList& result
+                                   )
+    {
+        AttrBuilder fnAttrs(context);
+        AttrBuilder retAttrs(context);
+        SmallVector<AttrBuilder, 8> argAttrs(numArgs, AttrBuilder(context));
+
+        for (size_t i = 0; i < numRecords; ++i)
+        {
+            LibLLVMAttributeRecord const& record = records[i];
+            AttrBuilder* pBuilder = nullptr;
+            if (record.Index == AttributeList::FunctionIndex)
+            {
+                pBuilder = &fnAttrs;
+            }
+            else if (record.Index == AttributeList::ReturnIndex)
+            {
+                pBuilder = &retAttrs;
+            }
+            else
+            {
+                unsigned argNo = record.Index - AttributeList::FirstArgIndex;
+                if (argNo >= numArgs)
+                {
+                    return LLVMCreateStringError("Attribute record index is out of range for the parameters");
+                }
+
+                pBuilder = &argAttrs[argNo];
+            }
+
+            Attribute attrib;
+            LLVMErrorRef err = MakeAttribute(context, record, attrib);
+            if (err != nullptr)
+            {
+                return err;
+            }
+
+            if (!IsAllowedAt(attrib, record.Index))
+            {
+                return LLVMCreateStringError("Attribute record is not allowed at the specified index");
+            }
+
+            pBuilder->addAttribute(attrib);
+        }
+
+        SmallVector<AttributeSet, 8> argSets;
+        argSets.reserve(numArgs);
+        for (AttrBuilder const& builder : argAttrs)
+        {
+            argSets.push_back(AttributeSet::get(context, builder));
+        }
+
+        result = AttributeList::get(context, AttributeSet::get(context, fnAttrs), AttributeSet::get(context, retAttrs), argSets);
+        return nullptr;
+    }
+
+    // Stream that writes directly into a caller supplied buffer without any allocation (it is unbuffered so
+    // raw_ostream never allocates a buffer of its own). Output that does not fit is dropped but still counted
+    // so that the required size is known after formatting.
+    class FixedBufferOStream final
+        : public raw_ostream
+    {
+    public:
+        FixedBufferOStream(char* buffer, size_t bufferLen)
+            : raw_ostream(/*unbuffered*/ true)
+            , Buffer(buffer)
+            , BufferLen(buffer == nullptr ? 0 : bufferLen)
+            , Pos(0)
+        {
+        }
+
+    private:
+        void write_impl(char const* ptr, size_t size) override
+        {
+            if (Pos < BufferLen)
+            {
+                std::memcpy(Buffer + Pos, ptr, std::min(size, BufferLen - Pos));
+            }
+
+            Pos += size;
+        }
+
+        uint64_t current_pos() const override
+        {
+            return Pos;
+        }
+
+        char* Buffer;
+        size_t BufferLen;
+        size_t Pos;
+    };
+
+    char const* GetModRefString(ModRefInfo modRef)
+    {
+        switch (modRef)
+        {
+        case ModRefInfo::NoModRef:
+            return "none";
+        case ModRefInfo::Ref:
+            return "read";
+        case ModRefInfo::Mod:
+            return "write";
+        case ModRefInfo::ModRef:
+            return "readwrite";
+        }
+
+        llvm_unreachable("Unknown ModRefInfo");
+    }
+
+    void PrintMemoryEffects(MemoryEffects effects, raw_ostream& os)
+    {
+        // The access kind of "other" is printed as the default for all locations not listed
+        bool first = true;
+        os << "memory(";
+        ModRefInfo otherModRef = effects.getModRef(IRMemLocation::Other);
+        if (otherModRef != ModRefInfo::NoModRef || effects.getModRef() == otherModRef)
+        {
+            first = false;
+            os << GetModRefString(otherModRef);
+        }
+
+        for (IRMemLocation location : MemoryEffects::locations())
+        {
+            ModRefInfo modRef = effects.getModRef(location);
+            if (modRef == otherModRef)
+            {
+                continue;
+            }
+
+            if (!first)
+            {
+                os << ", ";
+            }
+
+            first = false;
+            switch (location)
+            {
+            case IRMemLocation::ArgMem:
+                os << "argmem: ";
+                break;
+            case IRMemLocation::InaccessibleMem:
+                os << "inaccessiblemem: ";
+                break;
+            case IRMemLocation::Other:
+                llvm_unreachable("Other is printed as the default access kind");
+            }
+
+            os << GetModRefString(modRef);
+        }
+
+        os << ')';
+    }
+
+    void PrintAllocKind(AllocFnKind kind, raw_ostream& os)
+    {
+        constexpr std::pair<AllocFnKind, char const*> parts[] = {
+            { AllocFnKind::Alloc, "alloc" },
+            { AllocFnKind::Realloc, "realloc" },
+            { AllocFnKind::Free, "free" },
+            { AllocFnKind::Uninitialized, "uninitialized" },
+            { AllocFnKind::Zeroed, "zeroed" },
+            { AllocFnKind::Aligned, "aligned" },
+        };
+
+        char const* separator = "";
+        os << "allockind(\"";
+        for (auto const& [part, name] : parts)
+        {
+            if ((kind & part) != AllocFnKind::Unknown)
+            {
+                os << separator << name;
+                separator = ",";
+            }
+        }
+
+        os << "\")";
+    }
+
+    // The captures attribute is newer than some of the LLVM releases this has been validated against so the
+    // use of it is resolved by the template only when the kind exists.
+    template<typename TAttribute, typename = void>
+    struct HasCapturesKind : std::false_type {};
+
+    template<typename TAttribute>
+    struct HasCapturesKind<TAttribute, std::void_t<decltype(TAttribute::Captures)>> : std::true_type {};
+
+    template<typename TAttribute>
+    bool TryPrintCaptures(TAttribute attribute, raw_ostream& os)
+    {
+        if constexpr (HasCapturesKind<TAttribute>::value)
+        {
+            if (attribute.hasAttribute(TAttribute::Captures))
+            {
+                os << "captures(" << attribute.getCaptureInfo() << ')';
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Prints an attribute exactly as Attribute::getAsString() formats it (outside of an attribute group) but
+    // directly to a stream, as getAsString() always builds a new std::string. This MUST be kept in sync with
+    // the implementation in LLVM when the version is updated.
+    void PrintAttribute(Attribute attribute, raw_ostream& os)
+    {
+        if (!attribute.isValid())
+        {
+            return;
+        }
+
+        if (attribute.isStringAttribute())
+        {
+            os << '"' << attribute.getKindAsString() << '"';
+            StringRef value = attribute.getValueAsString();
+            if (!value.empty())
+            {
+                os << "=\"";
+                printEscapedString(value, os);
+                os << '"';
+            }
+
+            return;
+        }
+
+        Attribute::AttrKind kind = attribute.getKindAsEnum();
+        StringRef name = Attribute::getNameFromAttrKind(kind);
+        if (attribute.isEnumAttribute())
+        {
+            os << name;
+            return;
+        }
+
+        if (attribute.isTypeAttribute())
+        {
+            os << name << '(';
+            attribute.getValueAsType()->print(os, /*IsForDebug*/ false, /*NoDetails*/ true);
+            os << ')';
+            return;
+        }
+
+        if (attribute.isConstantRangeAttribute())
+        {
+            ConstantRange const& range = attribute.getValueAsConstantRange();
+            os << name << "(i" << range.getBitWidth() << ' ' << range.getLower() << ", " << range.getUpper() << ')';
+            return;
+        }
+
+        if (attribute.isConstantRangeListAttribute())
+        {
+            char const* separator = "";
+            os << name << '(';
+            for (ConstantRange const& range : attribute.getValueAsConstantRangeList())
+            {
+                os << separator << '(' << range.getLower() << ", " << range.getUpper() << ')';
+                separator = ", ";
+            }
+
+            os << ')';
+            return;
+        }
+
+        if (TryPrintCaptures(attribute, os))
+        {
+            return;
+        }
+
+        switch (kind)
+        {
+        case Attribute::Alignment:
+            os << "align " << attribute.getValueAsInt();
+            return;
+
+        case Attribute::AllocSize:
+            {
+                auto [elementSize, numElements] = attribute.getAllocSizeArgs();
+                os << "allocsize(" << elementSize;
+                if (numElements)
+                {
+                    os << ',' << *numElements;
+                }
+
+                os << ')';
+                return;
+            }
+
+        case Attribute::VScaleRange:
+            os << "vscale_range(" << attribute.getVScaleRangeMin() << ',' << attribute.getVScaleRangeMax().value_or(0) << ')';
+            return;
+
+        case Attribute::UWTable:
+            os << (attribute.getUWTableKind() == UWTableKind::Default ? "uwtable" : "uwtable(sync)");
+            return;
+
+        case Attribute::AllocKind:
+            PrintAllocKind(attribute.getAllocKind(), os);
+            return;
+
+        case Attribute::Memory:
+            PrintMemoryEffects(attribute.getMemoryEffects(), os);
+            return;
+
+        case Attribute::NoFPClass:
+            os << name << attribute.getNoFPClass();
+            return;
+
+        default:
+            // StackAlignment, Dereferenceable and DereferenceableOrNull
+            os << name << '(' << attribute.getValueAsInt() << ')';
+            return;
+        }
+    }
+
+    template<typename TFunc>
+    void ForEachAttribute(AttributeList const& attributes, TFunc&& func)
+    {
+        for (Attribute attrib : attributes.getFnAttrs())
+        {
+            func(AttributeList::FunctionIndex, attrib);
+        }
+
+        for (Attribute attrib : attributes.getRetAttrs())
+        {
+            func(AttributeList::ReturnIndex, attrib);
+        }
+
+        // Sets are stored as [function, return, args...]
+        for (unsigned argNo = 0; argNo + 2 < attributes.getNumAttrSets(); ++argNo)
+        {
+            for (Attribute attrib : attributes.getParamAttrs(argNo))
+            {
+                func(AttributeList::FirstArgIndex + argNo, attrib);
+            }
+        }
+    }
 }
 
 extern "C"
@@ -43,6 +603,33 @@ extern "C"
         return AllocateDisposeMessageFor(unwrap(attribute).getAsString());
     }
 
+    size_t LibLLVMAttributeToStringBuffer(LLVMAttributeRef attribute, char* buffer, size_t bufferLen)
+    {
+        FixedBufferOStream os(buffer, bufferLen);
+        PrintAttribute(unwrap(attribute), os);
+        os << '\0';
+        return os.tell();
+    }
+
+    size_t LibLLVMAttributesToStringBuffer(LLVMValueRef /*Function|CallBase*/ functionOrCall, char* buffer, size_t bufferLen)
+    {
+        AttributeList attributes;
+        if (!TryGetAttributes(unwrap(functionOrCall), attributes))
+        {
+            return 0;
+        }
+
+        // continue formatting after overflow to compute the total size required
+        FixedBufferOStream os(buffer, bufferLen);
+        ForEachAttribute(attributes, [&](unsigned /*index*/, Attribute attrib)
+        {
+            PrintAttribute(attrib, os);
+            os << '\0';
+        });
+
+        return os.tell();
+    }
+
     LLVMBool LibLLVMIsConstantRangeAttribute(LLVMAttributeRef atrribute)
     {
         auto Attr = unwrap(atrribute);
@@ -55,16 +642,9 @@ extern "C"
         return Attr.isConstantRangeListAttribute();
     }
 
-    STDEX_DECLARE_ENUM_FLAGS(LibLLVMAttributeAllowedOn);
-
-    constexpr LibLLVMAttributeAllowedOn AllowedOnAll
-        = LibLLVMAttributeAllowedOn_Return
-        | LibLLVMAttributeAllowedOn_Parameter
-        | LibLLVMAttributeAllowedOn_Function
-        | LibLLVMAttributeAllowedOn_CallSite
-        | LibLLVMAttributeAllowedOn_Global;
-
     static_assert(std::is_trivially_copyable_v<LibLLVMAttributeInfo>, "LibLLVMAttributeInfo must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMAttributeTableEntry>, "LibLLVMAttributeTableEntry must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMAttributeRecord>, "LibLLVMAttributeRecord must be blittable for stable ABI binding");
 
 // VS IDE will see an error E0289 on the definition of AllKnownAttributeNames that is NOT anything
 // that can be suppressed. It's JUST the IDE in editor experience for this declaration. (Hover, over
@@ -113,9 +693,6 @@ extern "C"
             return LLVMCreateStringError("Out ref parameter 'pInfo' is null!");
         }
 
-        // initialize to all members default;
-        *pInfo = {};
-
         // assume it is a custom string for simplicity of logic here.
         Attribute::AttrKind attribKind = Attribute::None;
 
@@ -126,75 +703,142 @@ extern "C"
             attribKind = Attribute::getAttrKindFromName(StringRef(attribName, nameLen));
         }
 
-        pInfo->ID = static_cast<unsigned>(attribKind);
-        if (attribKind == Attribute::None)
+        *pInfo = GetAttributeInfoTable()[attribKind].Info;
+        return nullptr;
+    }
+
+    LibLLVMAttributeTableEntry const* LibLLVMGetAttributeInfoTable(/*[Out]*/ size_t* numEntries)
+    {
+        if (numEntries == nullptr)
         {
-            // It's string attribute (No ID), there's currently no way to determine
-            // if a given string value is valid on any particular "index"
-            // String attributes have no Enum ID either...
-            pInfo->ArgKind = LibLLVMAttributeArgKind_String;
-            pInfo->AllowedOn = AllowedOnAll;
             return nullptr;
         }
 
-        // Enum attributes can have additional checks applied so provide details on that
+        auto const& table = GetAttributeInfoTable();
+        *numEntries = table.size();
+        return table.data();
+    }
 
-        if (Attribute::isEnumAttrKind(attribKind))
+    char const* LibLLVMGetAttributeNameFromID(uint32_t id, /*[Out]*/ uint32_t* len)
+    {
+        // getNameFromAttrKind() will hard assert/crash if given an out of range ID
+        // deal with that here and provide a known empty value
+        if( id >= (uint32_t)Attribute::AttrKind::EndAttrKinds )
         {
-            pInfo->ArgKind = LibLLVMAttributeArgKind_None;
+            *len = 0;
+            return nullptr;
         }
-        else if (Attribute::isIntAttrKind(attribKind))
+
+        StringRef stringRefVal = Attribute::getNameFromAttrKind(static_cast<Attribute::AttrKind>(id));
+        *len = stringRefVal.size();
+        return stringRefVal.data();
+    }
+
+    LLVMErrorRef LibLLVMSetAttributesFromRecords(LLVMValueRef /*Function|CallBase*/ functionOrCall, LibLLVMAttributeRecord const* records, size_t numRecords)
+    {
+        if (records == nullptr && numRecords > 0)
         {
-            pInfo->ArgKind = LibLLVMAttributeArgKind_Int;
+            return LLVMCreateStringError("records is null");
         }
-        else if (Attribute::isTypeAttrKind(attribKind))
+
+        Value* pValue = unwrap(functionOrCall);
+        unsigned numArgs = 0;
+        if (auto* pFunc = dyn_cast<Function>(pValue))
         {
-            pInfo->ArgKind = LibLLVMAttributeArgKind_Type;
+            numArgs = pFunc->getFunctionType()->getNumParams();
         }
-        else if (Attribute::isConstantRangeAttrKind(attribKind))
+        else if (auto* pCall = dyn_cast<CallBase>(pValue))
         {
-            pInfo->ArgKind = LibLLVMAttributeArgKind_ConstantRange;
+            numArgs = pCall->arg_size();
         }
-        else if (Attribute::isConstantRangeListAttrKind(attribKind))
+        else
         {
-            pInfo->ArgKind = LibLLVMAttributeArgKind_ConstantRangeList;
+            return LLVMCreateStringError("Value is not a function or call site");
         }
-        else
+
+        AttributeList attributes;
+        LLVMErrorRef err = BuildAttributeList(pValue->getContext(), numArgs, records, numRecords, attributes);
+        if (err != nullptr)
         {
-            pInfo->ArgKind = LibLLVMAttributeArgKind_None;
+            return err;
         }
 
-        pInfo->AllowedOn = LibLLVMAttributeAllowedOn_None;
-        if (Attribute::canUseAsFnAttr(attribKind))
+        if (auto* pFunc = dyn_cast<Function>(pValue))
         {
-            pInfo->AllowedOn |= LibLLVMAttributeAllowedOn_Function;
+            pFunc->setAttributes(attributes);
+        }
+        else
+        {
+            cast<CallBase>(pValue)->setAttributes(attributes);
         }
 
-        if (Attribute::canUseAsParamAttr(attribKind))
+        return nullptr;
+    }
+
+    size_t LibLLVMGetAttributeRecordCount(LLVMValueRef /*Function|CallBase*/ functionOrCall)
+    {
+        AttributeList attributes;
+        if (!TryGetAttributes(unwrap(functionOrCall), attributes))
         {
-            pInfo->AllowedOn |= LibLLVMAttributeAllowedOn_Parameter;
+            return 0;
         }
 
-        if (Attribute::canUseAsRetAttr(attribKind))
+        size_t retVal = 0;
+        for (AttributeSet attribSet : attributes)
         {
-            pInfo->AllowedOn |= LibLLVMAttributeAllowedOn_Return;
+            retVal += attribSet.getNumAttributes();
         }
 
-        return nullptr;
+        return retVal;
     }
 
-    char const* LibLLVMGetAttributeNameFromID(uint32_t id, /*[Out]*/ uint32_t* len)
+    LLVMErrorRef LibLLVMGetAttributeRecords(LLVMValueRef /*Function|CallBase*/ functionOrCall, /*(OUT, LibLLVMAttributeRecord[numRecords])*/ LibLLVMAttributeRecord* records, size_t numRecords)
     {
-        // getNameFromAttrKind() will hard assert/crash if given an out of range ID
-        // deal with that here and provide a known empty value
-        if( id >= (uint32_t)Attribute::AttrKind::EndAttrKinds )
+        AttributeList attributes;
+        if (!TryGetAttributes(unwrap(functionOrCall), attributes))
         {
-            *len = 0;
-            return nullptr;
+            return LLVMCreateStringError("Value is not a function or call site");
         }
 
-        StringRef stringRefVal = Attribute::getNameFromAttrKind(static_cast<Attribute::AttrKind>(id));
-        *len = stringRefVal.size();
-        return stringRefVal.data();
+        if (numRecords < LibLLVMGetAttributeRecordCount(functionOrCall))
+        {
+            return LLVMCreateStringError("Records array is too small, use LibLLVMGetAttributeRecordCount() to get the minimum required size");
+        }
+
+        if (records == nullptr && numRecords > 0)
+        {
+            return LLVMCreateStringError("records is null");
+        }
+
+        size_t i = 0;
+        ForEachAttribute(attributes, [&](unsigned index, Attribute attrib)
+        {
+            LibLLVMAttributeRecord& record = records[i++];
+            record = {};
+            record.Index = index;
+            record.AttributeRef = wrap(attrib);
+            if (attrib.isStringAttribute())
+            {
+                StringRef kind = attrib.getKindAsString();
+                StringRef value = attrib.getValueAsString();
+                record.StringKind = kind.data();
+                record.StringKindLen = kind.size();
+                record.StringValue = value.data();
+                record.StringValueLen = value.size();
+                return;
+            }
+
+            record.ID = static_cast<uint32_t>(attrib.getKindAsEnum());
+            if (attrib.isIntAttribute())
+            {
+                record.IntValue = attrib.getValueAsInt();
+            }
+            else if (attrib.isTypeAttribute())
+            {
+                record.TypeValue = wrap(attrib.getValueAsType());
+            }
+        });
+
+        return nullptr;
     }
 }
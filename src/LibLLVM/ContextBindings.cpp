@@ -1,7 +1,659 @@
+#include <mutex>
+#include <vector>
+
 #include "libllvm-c/ContextBindings.h"
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SetVector.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/IR/Attributes.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/DebugProgramInstruction.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalAlias.h>
+#include <llvm/IR/GlobalIFunc.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Metadata.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Operator.h>
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/Remarks/RemarkStreamer.h>
+#include <llvm/IR/LLVMRemarkStreamer.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/CBindingWrapping.h>
 
 using namespace llvm;
+using namespace llvm::orc;
+
+namespace
+{
+    // Lifted from llvm/lib/IR/LLVMContextImpl.h as it is not in any headers. The set of modules owned by a
+    // context is ONLY available from the private implementation of the context, so this declares ONLY the
+    // leading member of that class, which is the only one used. The shape of this **MUST** match what is in
+    // LLVM and can only be verified by inspection. The version checks below will enforce that.
+    struct LLVMContextImplPrefix
+    {
+        /// OwnedModules - The set of modules instantiated in this context, and which
+        /// will be automatically deleted if this context is deleted.
+        SmallPtrSet<Module*, 4> OwnedModules;
+    };
+
+// sanity check to catch any changes in the official LLVM declaration of the class above.
+// Since it is NOT declared in a header this **MUST** be validated on any changes.
+#if LLVM_VERSION_MAJOR != 20 || LLVM_VERSION_MINOR != 1 || LLVM_VERSION_PATCH != 8
+#error "Re-evaluate and match declaration of the leading members of LLVMContextImpl; update the version test values above when validated"
+#endif
+
+    SmallPtrSetImpl<Module*> const& GetOwnedModules(LLVMContext const& context)
+    {
+        return reinterpret_cast<LLVMContextImplPrefix const*>(context.pImpl)->OwnedModules;
+    }
+
+    // Restores the configurable state of a context to the defaults of a newly constructed
+    // context so that a recycled context has no lingering behavior from a previous lease.
+    void ResetContextOptions(LLVMContext& context)
+    {
+        context.setDiagnosticHandler(std::make_unique<DiagnosticHandler>());
+        context.setYieldCallback(nullptr, nullptr);
+        context.setDiscardValueNames(false);
+        context.disableDebugTypeODRUniquing();
+        context.setDiagnosticsHotnessRequested(false);
+        context.setMainRemarkStreamer(nullptr);
+        context.setLLVMRemarkStreamer(nullptr);
+    }
+
+    // Size of a node, including the operands, based on the actual leaf class of the node
+    uint64_t GetNodeBytes(MDNode const& node)
+    {
+        uint64_t operandBytes = node.getNumOperands() * sizeof(MDOperand);
+        switch (node.getMetadataID())
+        {
+#define HANDLE_MDNODE_LEAF(CLASS) case Metadata::CLASS##Kind: return sizeof(CLASS) + operandBytes;
+#include "llvm/IR/Metadata.def"
+#undef HANDLE_MDNODE_LEAF
+        default:
+            return sizeof(MDNode) + operandBytes;
+        }
+    }
+
+    void Accumulate(LibLLVMReachableIRStats& stats, uint64_t bytes)
+    {
+        ++stats.Count;
+        stats.EstimatedBytes += bytes;
+    }
+
+    // Uniqued state of a context that is reachable from its modules. The uniquing tables of the context are
+    // private to LLVM so this is the only part of the state that is visible through the public API.
+    class ReachableState
+    {
+    public:
+        void AddModule(Module const& module)
+        {
+            for (NamedMDNode const& node : module.named_metadata())
+            {
+                for (MDNode const* pOperand : node.operands())
+                {
+                    AddMetadata(pOperand);
+                }
+            }
+
+            for (GlobalVariable const& global : module.globals())
+            {
+                AddGlobalObject(global);
+                AddType(global.getValueType());
+                if (global.hasInitializer())
+                {
+                    AddValue(global.getInitializer());
+                }
+            }
+
+            for (GlobalAlias const& alias : module.aliases())
+            {
+                AddValue(alias.getAliasee());
+            }
+
+            for (GlobalIFunc const& ifunc : module.ifuncs())
+            {
+                AddValue(ifunc.getResolver());
+            }
+
+            for (Function const& function : module)
+            {
+                AddFunction(function);
+            }
+
+            ProcessWorkList();
+        }
+
+        SmallPtrSet<Constant*, 32> Constants;
+        SmallPtrSet<Metadata const*, 32> Nodes;
+        SmallPtrSet<Type*, 16> Types;
+        SmallPtrSet<void*, 16> Attributes;
+        DenseSet<AttributeSet> AttributeSets;
+        DenseSet<AttributeList> AttributeLists;
+
+    private:
+        void AddFunction(Function const& function)
+        {
+            AddGlobalObject(function);
+            AddType(function.getFunctionType());
+            AddAttributes(function.getAttributes());
+            if (function.hasPersonalityFn())
+            {
+                AddValue(function.getPersonalityFn());
+            }
+
+            if (function.hasPrefixData())
+            {
+                AddValue(function.getPrefixData());
+            }
+
+            if (function.hasPrologueData())
+            {
+                AddValue(function.getPrologueData());
+            }
+
+            SmallVector<std::pair<unsigned, MDNode*>, 4> attachments;
+            for (Instruction const& inst : instructions(function))
+            {
+                AddValue(&inst);
+                if (auto const* pAlloca = dyn_cast<AllocaInst>(&inst))
+                {
+                    AddType(pAlloca->getAllocatedType());
+                }
+
+                for (Value const* pOperand : inst.operands())
+                {
+                    AddValue(pOperand);
+                }
+
+                attachments.clear();
+                inst.getAllMetadata(attachments);
+                for (auto const& [kind, pNode] : attachments)
+                {
+                    AddMetadata(pNode);
+                }
+
+                if (auto const* pCall = dyn_cast<CallBase>(&inst))
+                {
+                    AddType(pCall->getFunctionType());
+                    AddAttributes(pCall->getAttributes());
+                }
+
+                for (DbgRecord const& record : inst.getDbgRecordRange())
+                {
+                    AddMetadata(record.getDebugLoc().getAsMDNode());
+                    if (auto const* pVariable = dyn_cast<DbgVariableRecord>(&record))
+                    {
+                        AddMetadata(pVariable->getRawVariable());
+                        AddMetadata(pVariable->getRawExpression());
+                        AddMetadata(pVariable->getRawLocation());
+                        if (pVariable->isDbgAssign())
+                        {
+                            AddMetadata(pVariable->getRawAddress());
+                            AddMetadata(pVariable->getRawAddressExpression());
+                            AddMetadata(pVariable->getRawAssignID());
+                        }
+                    }
+                    else if (auto const* pLabel = dyn_cast<DbgLabelRecord>(&record))
+                    {
+                        AddMetadata(pLabel->getLabel());
+                    }
+                }
+            }
+        }
+
+        void AddGlobalObject(GlobalObject const& global)
+        {
+            SmallVector<std::pair<unsigned, MDNode*>, 4> attachments;
+            global.getAllMetadata(attachments);
+            for (auto const& [kind, pNode] : attachments)
+            {
+                AddMetadata(pNode);
+            }
+        }
+
+        void AddAttributes(AttributeList list)
+        {
+            if (list.isEmpty() || !AttributeLists.insert(list).second)
+            {
+                return;
+            }
+
+            for (AttributeSet set : list)
+            {
+                if (set.hasAttributes() && AttributeSets.insert(set).second)
+                {
+                    for (Attribute attr : set)
+                    {
+                        Attributes.insert(attr.getRawPointer());
+                        if (attr.isTypeAttribute())
+                        {
+                            AddType(attr.getValueAsType());
+                        }
+                    }
+                }
+            }
+        }
+
+        void AddType(Type* pType)
+        {
+            if (pType != nullptr && Types.insert(pType).second)
+            {
+                for (Type* pContained : pType->subtypes())
+                {
+                    AddType(pContained);
+                }
+            }
+        }
+
+        // Global values and function local values are not uniqued so only their types, constants and metadata
+        // are followed
+        void AddValue(Value const* pValue)
+        {
+            if (pValue == nullptr)
+            {
+                return;
+            }
+
+            AddType(pValue->getType());
+            if (auto const* pGep = dyn_cast<GEPOperator>(pValue))
+            {
+                AddType(pGep->getSourceElementType());
+            }
+
+            if (auto const* pConst = dyn_cast<Constant>(pValue))
+            {
+                if (!isa<GlobalValue>(pConst) && Constants.insert(const_cast<Constant*>(pConst)).second)
+                {
+                    ConstantWork.push_back(pConst);
+                }
+            }
+            else if (auto const* pMetadataValue = dyn_cast<MetadataAsValue>(pValue))
+            {
+                AddMetadata(pMetadataValue->getMetadata());
+            }
+        }
+
+        void AddMetadata(Metadata const* pMetadata)
+        {
+            if (pMetadata != nullptr && Nodes.insert(pMetadata).second)
+            {
+                MetadataWork.push_back(pMetadata);
+            }
+        }
+
+        // Constants and metadata can nest deeply so the operands are followed without recursion
+        void ProcessWorkList()
+        {
+            while (!ConstantWork.empty() || !MetadataWork.empty())
+            {
+                if (!ConstantWork.empty())
+                {
+                    Constant const* pConst = ConstantWork.pop_back_val();
+                    for (Value const* pOperand : pConst->operands())
+                    {
+                        AddValue(pOperand);
+                    }
+
+                    continue;
+                }
+
+                Metadata const* pMetadata = MetadataWork.pop_back_val();
+                if (auto const* pNode = dyn_cast<MDNode>(pMetadata))
+                {
+                    for (MDOperand const& operand : pNode->operands())
+                    {
+                        AddMetadata(operand.get());
+                    }
+                }
+                else if (auto const* pValue = dyn_cast<ValueAsMetadata>(pMetadata))
+                {
+                    AddValue(pValue->getValue());
+                }
+                else if (auto const* pArgs = dyn_cast<DIArgList>(pMetadata))
+                {
+                    for (ValueAsMetadata const* pArg : pArgs->getArgs())
+                    {
+                        AddMetadata(pArg);
+                    }
+                }
+            }
+        }
+
+        SmallVector<Constant const*, 64> ConstantWork;
+        SmallVector<Metadata const*, 64> MetadataWork;
+    };
+
+    uint64_t GetTypeBytes(Type const& type)
+    {
+        uint64_t bytes = sizeof(Type) + type.getNumContainedTypes() * sizeof(Type*);
+        if (auto const* pStruct = dyn_cast<StructType>(&type); pStruct != nullptr && pStruct->hasName())
+        {
+            bytes += pStruct->getName().size();
+        }
+
+        return bytes;
+    }
+
+    // Estimated size of a constant based on its actual class. Operands of users are co-allocated ahead of the
+    // object and the elements of data sequentials are held in the constant; neither includes allocator overhead.
+    void AccumulateConstant(Constant const& constant, LibLLVMReachableIREstimate& estimate)
+    {
+        uint64_t operandBytes = constant.getNumOperands() * sizeof(Use);
+        if (auto const* pData = dyn_cast<ConstantDataSequential>(&constant))
+        {
+            uint64_t objectBytes = isa<ConstantDataArray>(pData) ? sizeof(ConstantDataArray) : sizeof(ConstantDataVector);
+            Accumulate(estimate.DataConstants, objectBytes + pData->getRawDataValues().size());
+        }
+        else if (isa<ConstantArray>(constant))
+        {
+            Accumulate(estimate.AggregateConstants, sizeof(ConstantArray) + operandBytes);
+        }
+        else if (isa<ConstantStruct>(constant))
+        {
+            Accumulate(estimate.AggregateConstants, sizeof(ConstantStruct) + operandBytes);
+        }
+        else if (isa<ConstantVector>(constant))
+        {
+            Accumulate(estimate.AggregateConstants, sizeof(ConstantVector) + operandBytes);
+        }
+        else if (isa<ConstantExpr>(constant))
+        {
+            Accumulate(estimate.ExpressionConstants, sizeof(ConstantExpr) + operandBytes);
+        }
+        else if (isa<ConstantInt>(constant))
+        {
+            Accumulate(estimate.ScalarConstants, sizeof(ConstantInt));
+        }
+        else if (isa<ConstantFP>(constant))
+        {
+            Accumulate(estimate.ScalarConstants, sizeof(ConstantFP));
+        }
+        else if (isa<ConstantAggregateZero>(constant) || isa<ConstantPointerNull>(constant)
+              || isa<ConstantTargetNone>(constant) || isa<UndefValue>(constant))
+        {
+            Accumulate(estimate.ScalarConstants, sizeof(ConstantData));
+        }
+    }
+
+    void EstimateReachableIR(ArrayRef<Module*> modules, LibLLVMReachableIREstimate& estimate)
+    {
+        estimate = {};
+
+        ReachableState state;
+        for (Module const* pModule : modules)
+        {
+            state.AddModule(*pModule);
+        }
+
+        for (Constant const* pConst : state.Constants)
+        {
+            AccumulateConstant(*pConst, estimate);
+        }
+
+        for (Type const* pType : state.Types)
+        {
+            Accumulate(estimate.Types, GetTypeBytes(*pType));
+        }
+
+        for (Metadata const* pMetadata : state.Nodes)
+        {
+            if (auto const* pNode = dyn_cast<MDNode>(pMetadata))
+            {
+                Accumulate(pNode->isDistinct() ? estimate.DistinctMDNodes : estimate.UniquedMDNodes, GetNodeBytes(*pNode));
+            }
+            else if (auto const* pString = dyn_cast<MDString>(pMetadata))
+            {
+                Accumulate(estimate.MDStrings, sizeof(StringMapEntry<MDString>) + pString->getLength() + 1);
+            }
+        }
+
+        // The implementation objects of attributes are private to LLVM so only the data of string attributes has
+        // a known size; Enum, integer and type attributes are counted with no bytes.
+        for (void* pAttr : state.Attributes)
+        {
+            Attribute attr = Attribute::fromRawPointer(pAttr);
+            Accumulate(estimate.Attributes, attr.isStringAttribute() ? attr.getKindAsString().size() + attr.getValueAsString().size() : 0);
+        }
+
+        for (AttributeSet set : state.AttributeSets)
+        {
+            Accumulate(estimate.AttributeSets, set.getNumAttributes() * sizeof(Attribute));
+        }
+
+        for (AttributeList list : state.AttributeLists)
+        {
+            Accumulate(estimate.AttributeLists, (list.end() - list.begin()) * sizeof(AttributeSet));
+        }
+
+        estimate.ModuleCount = static_cast<uint32_t>(modules.size());
+    }
+
+    // Only aggregates and expressions are trimmed. A constant with no uses may still be referenced by metadata
+    // (i.e. ConstantAsMetadata in debug info) or by a value handle; neither is a use so both are tested as
+    // destroying the constant would silently null out the reference.
+    bool IsTrimmable(Constant const& constant)
+    {
+        return (isa<ConstantAggregate>(constant) || isa<ConstantExpr>(constant))
+            && constant.use_empty()
+            && !constant.isUsedByMetadata()
+            && !constant.hasValueHandle();
+    }
+
+    uint64_t TrimUnusedConstants(ArrayRef<Module*> modules)
+    {
+        ReachableState state;
+        for (Module const* pModule : modules)
+        {
+            state.AddModule(*pModule);
+        }
+
+        // Unused constants are found through the users of the global values and of the constants used by the
+        // modules; A constant that refers to neither is not reachable through the public API.
+        SmallVector<Constant*, 64> work(state.Constants.begin(), state.Constants.end());
+        for (Module* pModule : modules)
+        {
+            for (GlobalValue& global : pModule->global_values())
+            {
+                work.push_back(&global);
+            }
+        }
+
+        SmallPtrSet<Constant*, 32> visited;
+        SmallVector<Constant*, 64> unused;
+        while (!work.empty())
+        {
+            Constant* pConst = work.pop_back_val();
+            for (User* pUser : pConst->users())
+            {
+                auto* pUserConst = dyn_cast<Constant>(pUser);
+                if (pUserConst == nullptr || isa<GlobalValue>(pUserConst) || !visited.insert(pUserConst).second)
+                {
+                    continue;
+                }
+
+                if (IsTrimmable(*pUserConst))
+                {
+                    unused.push_back(pUserConst);
+                }
+                else
+                {
+                    work.push_back(pUserConst);
+                }
+            }
+        }
+
+        // destroying a constant may leave its operands unused so the operands are tested after each round.
+        // A constant in the list has no users, thus it is never the operand of another, and destroying one
+        // can never destroy another in the same list.
+        uint64_t numDestroyed = 0;
+        SmallSetVector<Constant*, 16> operands;
+        while (!unused.empty())
+        {
+            operands.clear();
+            for (Constant* pConst : unused)
+            {
+                for (Value* pOperand : pConst->operands())
+                {
+                    auto* pOperandConst = dyn_cast<Constant>(pOperand);
+                    if (pOperandConst != nullptr && !isa<GlobalValue>(pOperandConst))
+                    {
+                        operands.insert(pOperandConst);
+                    }
+                }
+            }
+
+            for (Constant* pConst : unused)
+            {
+                pConst->destroyConstant();
+            }
+
+            numDestroyed += unused.size();
+            unused.clear();
+            for (Constant* pConst : operands)
+            {
+                if (IsTrimmable(*pConst))
+                {
+                    unused.push_back(pConst);
+                }
+            }
+        }
+
+        return numDestroyed;
+    }
+
+    SmallVector<Module*, 4> GetModules(LLVMContext const& context)
+    {
+        auto const& modules = GetOwnedModules(context);
+        return SmallVector<Module*, 4>(modules.begin(), modules.end());
+    }
+
+    // Pool of contexts leased to a thread for exclusive use
+    // Every context is held as an ORC ThreadSafeContext. This allows leasing the same
+    // pool of contexts as either a raw LLVMContext or as a ThreadSafeContext for use
+    // with the ORC JIT. (A ThreadSafeContext is a shared reference to the context so
+    // the pool retains one reference for the lifetime of the context).
+    class ContextPool
+    {
+    public:
+        ContextPool(uint32_t preWarmCount, uint32_t maxRetained, uint32_t maxLeasesPerContext)
+            : MaxRetained(maxRetained)
+            , MaxLeasesPerContext(maxLeasesPerContext)
+        {
+            Idle.reserve(preWarmCount);
+            for(uint32_t i = 0; i < preWarmCount; ++i)
+            {
+                Idle.push_back({ ThreadSafeContext(std::make_unique<LLVMContext>()), 0 });
+            }
+        }
+
+        ThreadSafeContext Lease()
+        {
+            std::unique_lock<std::mutex> lock(Lock);
+            PooledContext retVal;
+            if (Idle.empty())
+            {
+                // Don't hold the lock while constructing a new context.
+                lock.unlock();
+                retVal.Context = ThreadSafeContext(std::make_unique<LLVMContext>());
+                lock.lock();
+            }
+            else
+            {
+                retVal = std::move(Idle.back());
+                Idle.pop_back();
+            }
+
+            ++retVal.NumLeases;
+            auto [it, inserted] = Leased.try_emplace(retVal.Context.getContext(), std::move(retVal));
+            return it->second.Context;
+        }
+
+        void Release(LLVMContext* pContext)
+        {
+            PooledContext pooled;
+            {
+                std::lock_guard<std::mutex> lock(Lock);
+                auto it = Leased.find(pContext);
+                if (it == Leased.end())
+                {
+                    // Not a context leased from this pool; nothing to do.
+                    return;
+                }
+
+                pooled = std::move(it->second);
+                Leased.erase(it);
+            }
+
+            // The context is still exclusively held by the caller at this point
+            // so there's no need to hold the lock while resetting or testing it.
+            if (!CanRecycle(*pContext, pooled.NumLeases))
+            {
+                // pooled going out of scope releases the pool's reference to the context
+                return;
+            }
+
+            ResetContextOptions(*pContext);
+
+            std::lock_guard<std::mutex> lock(Lock);
+            if (MaxRetained == 0 || Idle.size() < MaxRetained)
+            {
+                Idle.push_back(std::move(pooled));
+            }
+        }
+
+        uint32_t GetIdleCount()
+        {
+            std::lock_guard<std::mutex> lock(Lock);
+            return static_cast<uint32_t>(Idle.size());
+        }
+
+        uint32_t GetLeasedCount()
+        {
+            std::lock_guard<std::mutex> lock(Lock);
+            return Leased.size();
+        }
+
+    private:
+        struct PooledContext
+        {
+            ThreadSafeContext Context;
+            uint32_t NumLeases = 0;
+        };
+
+        bool CanRecycle(LLVMContext const& context, uint32_t numLeases) const
+        {
+            // A context that still owns modules is not "clean"; it is destroyed (along with the modules)
+            if (!GetOwnedModules(context).empty())
+            {
+                return false;
+            }
+
+            // The uniqued state of a context only grows and the memory it retains is private to LLVM, so the
+            // number of leases is the bound on how much a recycled context can accumulate.
+            return MaxLeasesPerContext == 0 || numLeases < MaxLeasesPerContext;
+        }
+
+        uint32_t const MaxRetained;
+        uint32_t const MaxLeasesPerContext;
+        std::mutex Lock;
+        std::vector<PooledContext> Idle;
+        DenseMap<LLVMContext*, PooledContext> Leased;
+    };
+
+    DEFINE_SIMPLE_CONVERSION_FUNCTIONS(ContextPool, LibLLVMContextPoolRef)
+    DEFINE_SIMPLE_CONVERSION_FUNCTIONS(ThreadSafeContext, LLVMOrcThreadSafeContextRef)
+}
 
 extern "C"
 {
@@ -22,4 +674,62 @@ extern "C"
             pContext->disableDebugTypeODRUniquing( );
         }
     }
+
+    LibLLVMContextPoolRef LibLLVMCreateContextPool( uint32_t preWarmCount, uint32_t maxRetained, uint32_t maxLeasesPerContext )
+    {
+        return wrap( new ContextPool( preWarmCount, maxRetained, maxLeasesPerContext ) );
+    }
+
+    void LibLLVMDisposeContextPool( LibLLVMContextPoolRef pool )
+    {
+        delete unwrap( pool );
+    }
+
+    LLVMContextRef LibLLVMContextPoolLease( LibLLVMContextPoolRef pool )
+    {
+        return wrap( unwrap( pool )->Lease( ).getContext( ) );
+    }
+
+    void LibLLVMContextPoolRelease( LibLLVMContextPoolRef pool, LLVMContextRef context )
+    {
+        unwrap( pool )->Release( unwrap( context ) );
+    }
+
+    LLVMOrcThreadSafeContextRef LibLLVMContextPoolLeaseThreadSafe( LibLLVMContextPoolRef pool )
+    {
+        return wrap( new ThreadSafeContext( unwrap( pool )->Lease( ) ) );
+    }
+
+    void LibLLVMContextPoolReleaseThreadSafe( LibLLVMContextPoolRef pool, LLVMOrcThreadSafeContextRef context )
+    {
+        ThreadSafeContext* pTsc = unwrap( context );
+        unwrap( pool )->Release( pTsc->getContext( ) );
+        delete pTsc;
+    }
+
+    uint32_t LibLLVMContextPoolGetIdleCount( LibLLVMContextPoolRef pool )
+    {
+        return unwrap( pool )->GetIdleCount( );
+    }
+
+    uint32_t LibLLVMContextPoolGetLeasedCount( LibLLVMContextPoolRef pool )
+    {
+        return unwrap( pool )->GetLeasedCount( );
+    }
+
+    LLVMErrorRef LibLLVMContextEstimateReachableIR( LLVMContextRef context, /*[out, byref]*/ LibLLVMReachableIREstimate* pEstimate )
+    {
+        if (pEstimate == nullptr)
+        {
+            return LLVMCreateStringError( "Out ref parameter 'pEstimate' is null!" );
+        }
+
+        EstimateReachableIR( GetModules( *unwrap( context ) ), *pEstimate );
+        return nullptr;
+    }
+
+    uint64_t LibLLVMContextTrimUnusedConstants( LLVMContextRef context )
+    {
+        return TrimUnusedConstants( GetModules( *unwrap( context ) ) );
+    }
 }
@@ -1,9 +1,215 @@
+#include <type_traits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 #include "libllvm-c/DataLayoutBindings.h"
 #include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Type.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/Error.h>
+#include <llvm/Support/xxhash.h>
 
 using namespace llvm;
 
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMTypeLayout>, "LibLLVMTypeLayout must be blittable for stable ABI binding");
+
+    void GetTypeLayout(DataLayout const& layout, Type* pType, LibLLVMTypeLayout& result)
+    {
+        TypeSize bitSize = layout.getTypeSizeInBits(pType);
+        result.StoreSize = layout.getTypeStoreSize(pType).getKnownMinValue();
+        result.AllocSize = layout.getTypeAllocSize(pType).getKnownMinValue();
+        result.BitSize = bitSize.getKnownMinValue();
+        result.AbiAlignment = static_cast<uint32_t>(layout.getABITypeAlign(pType).value());
+        result.PrefAlignment = static_cast<uint32_t>(layout.getPrefTypeAlign(pType).value());
+        result.IsScalable = bitSize.isScalable();
+    }
+
+    // Equality of layouts compares the parsed specifications and NOT the string, which is not canonical, so the
+    // hash is computed from the answers of the layout to a fixed set of queries. Equal layouts always give the
+    // same answers and thus the same hash; distinct layouts that only differ for types or address spaces not
+    // queried here collide, which is valid for a hash. The types for the queries come from a context of the
+    // calling thread as a context is not thread safe and this is called from any thread. Only types that are
+    // NOT cached by the layout are queried (no struct types) so the layout keeps no reference to the context.
+    uint64_t ComputeHash(DataLayout const& layout)
+    {
+        thread_local LLVMContext context;
+        SmallVector<uint64_t, 96> values;
+        auto addTypeLayout = [&](Type* pType)
+            {
+                values.push_back(layout.getTypeSizeInBits(pType).getKnownMinValue());
+                values.push_back(layout.getABITypeAlign(pType).value());
+                values.push_back(layout.getPrefTypeAlign(pType).value());
+            };
+
+        auto addPointerLayout = [&](unsigned addressSpace)
+            {
+                values.push_back(layout.getPointerSize(addressSpace));
+                values.push_back(layout.getIndexSize(addressSpace));
+                values.push_back(layout.getPointerABIAlignment(addressSpace).value());
+                values.push_back(layout.getPointerPrefAlignment(addressSpace).value());
+            };
+
+        values.push_back(layout.isBigEndian());
+        values.push_back(layout.getAllocaAddrSpace());
+        values.push_back(layout.getProgramAddressSpace());
+        values.push_back(layout.getDefaultGlobalsAddressSpace());
+        values.push_back(layout.getFunctionPtrAlign().valueOrOne().value());
+        values.push_back(layout.getFunctionPtrAlign().has_value());
+        values.push_back(static_cast<uint64_t>(layout.getFunctionPtrAlignType()));
+        values.push_back(static_cast<uint64_t>(layout.getGlobalPrefix()));
+        values.push_back(xxh3_64bits(layout.getPrivateGlobalPrefix()));
+        values.push_back(layout.hasMicrosoftFastStdCallMangling());
+        values.push_back(layout.getLargestLegalIntTypeSizeInBits());
+
+        // The natural stack alignment is optional and only visible as a comparison
+        uint64_t stackAlignBits = 0;
+        for (unsigned shift = 0; shift < 32; ++shift)
+        {
+            stackAlignBits |= uint64_t(layout.exceedsNaturalStackAlignment(Align(uint64_t(1) << shift))) << shift;
+        }
+
+        values.push_back(stackAlignBits);
+        for (unsigned addressSpace : layout.getNonIntegralAddressSpaces())
+        {
+            values.push_back(addressSpace);
+        }
+
+        addPointerLayout(0);
+        addPointerLayout(layout.getAllocaAddrSpace());
+        addPointerLayout(layout.getProgramAddressSpace());
+        addPointerLayout(layout.getDefaultGlobalsAddressSpace());
+
+        for (unsigned bitWidth : { 1, 8, 16, 32, 64, 128 })
+        {
+            values.push_back(layout.isLegalInteger(bitWidth));
+            addTypeLayout(IntegerType::get(context, bitWidth));
+        }
+
+        for (Type* pType : { Type::getHalfTy(context)
+                           , Type::getBFloatTy(context)
+                           , Type::getFloatTy(context)
+                           , Type::getDoubleTy(context)
+                           , Type::getX86_FP80Ty(context)
+                           , Type::getFP128Ty(context)
+                           , Type::getPPC_FP128Ty(context)
+                           })
+        {
+            addTypeLayout(pType);
+        }
+
+        for (unsigned numElements : { 2, 4, 8, 16 })
+        {
+            addTypeLayout(FixedVectorType::get(Type::getInt32Ty(context), numElements));
+        }
+
+        return xxh3_64bits(ArrayRef<uint8_t>(reinterpret_cast<uint8_t const*>(values.data()), values.size() * sizeof(uint64_t)));
+    }
+
+    // Process wide table of interned layouts
+    // The table maps the exact string provided to the interned layout. Distinct strings that
+    // parse to an equal layout share the same instance. There are very few distinct layouts in
+    // any real application so finding an equal layout for a new string is a simple linear search.
+    class DataLayoutInternTable
+    {
+    public:
+        Expected<DataLayout const*> Intern(StringRef str)
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock(Lock);
+                auto it = ByName.find(str);
+                if (it != ByName.end())
+                {
+                    return it->second;
+                }
+            }
+
+            // Parse outside of the lock, it's the expensive part
+            Expected<DataLayout> parsed = DataLayout::parse(str);
+            if (!parsed)
+            {
+                return parsed.takeError();
+            }
+
+            std::unique_lock<std::shared_mutex> lock(Lock);
+            DataLayout const* pLayout = nullptr;
+            for (auto const& owned : Owned)
+            {
+                if (*owned == *parsed)
+                {
+                    pLayout = owned.get();
+                    break;
+                }
+            }
+
+            if (pLayout == nullptr)
+            {
+                Owned.push_back(std::make_unique<DataLayout>(std::move(*parsed)));
+                pLayout = Owned.back().get();
+                Hashes[pLayout] = ComputeHash(*pLayout);
+            }
+
+            // If another thread won the race for the same name this is a NOP
+            ByName.try_emplace(str, pLayout);
+            return pLayout;
+        }
+
+        bool IsInterned(DataLayout const* pLayout)
+        {
+            uint64_t hash;
+            return TryGetHash(pLayout, hash);
+        }
+
+        bool TryGetHash(DataLayout const* pLayout, uint64_t& hash)
+        {
+            std::shared_lock<std::shared_mutex> lock(Lock);
+            auto it = Hashes.find(pLayout);
+            if (it == Hashes.end())
+            {
+                return false;
+            }
+
+            hash = it->second;
+            return true;
+        }
+
+        static DataLayoutInternTable& Instance()
+        {
+            static DataLayoutInternTable table;
+            return table;
+        }
+
+    private:
+        std::shared_mutex Lock;
+        StringMap<DataLayout const*> ByName;
+        std::vector<std::unique_ptr<DataLayout>> Owned;
+        DenseMap<DataLayout const*, uint64_t> Hashes;
+    };
+
+    // Runs queries with a layout. The struct layout cache of a DataLayout is NOT thread safe and is keyed by the
+    // address of the type, which is re-used once the context that owns the type is destroyed. An interned layout
+    // is shared by all threads and outlives any context, so queries of an interned layout run on a private copy
+    // (a copy does NOT share the cache) that is discarded when the queries are done.
+    template<typename TFunc>
+    auto WithQueryLayout(DataLayout const& layout, TFunc&& func)
+    {
+        if (DataLayoutInternTable::Instance().IsInterned(&layout))
+        {
+            DataLayout copy(layout);
+            return func(copy);
+        }
+
+        return func(layout);
+    }
+}
+
 extern "C"
 {
     LLVMErrorRef LibLLVMParseDataLayout(char const* layoutString, size_t strLen, /*out*/ LLVMTargetDataRef* outRetVal)
@@ -22,6 +228,100 @@ extern "C"
 
     LLVMBool LibLLVMTargeDataRefOpEquals(LLVMTargetDataRef lhs, LLVMTargetDataRef rhs)
     {
-        return *unwrap(lhs) == *unwrap(rhs) ? 1 : 0;
+        return lhs == rhs || *unwrap(lhs) == *unwrap(rhs) ? 1 : 0;
+    }
+
+    LLVMErrorRef LibLLVMInternDataLayout(char const* layoutString, size_t strLen, /*out*/ LLVMTargetDataRef* outRetVal)
+    {
+        Expected<DataLayout const*> expectedResult = DataLayoutInternTable::Instance().Intern(StringRef(layoutString, strLen));
+        *outRetVal = expectedResult ? wrap(*expectedResult) : nullptr;
+        return expectedResult ? 0 : wrap(expectedResult.takeError());
+    }
+
+    LLVMBool LibLLVMDataLayoutIsInterned(LLVMTargetDataRef dataLayout)
+    {
+        return DataLayoutInternTable::Instance().IsInterned(unwrap(dataLayout)) ? 1 : 0;
+    }
+
+    void LibLLVMDisposeDataLayout(LLVMTargetDataRef dataLayout)
+    {
+        DataLayout const* pLayout = unwrap(dataLayout);
+        if (!DataLayoutInternTable::Instance().IsInterned(pLayout))
+        {
+            delete pLayout;
+        }
+    }
+
+    uint64_t LibLLVMDataLayoutGetHash(LLVMTargetDataRef dataLayout)
+    {
+        DataLayout const* pLayout = unwrap(dataLayout);
+        uint64_t hash;
+        return DataLayoutInternTable::Instance().TryGetHash(pLayout, hash) ? hash : ComputeHash(*pLayout);
+    }
+
+    LLVMErrorRef LibLLVMGetTypeLayouts( LLVMTargetDataRef dataLayout
+                                      , LLVMTypeRef const* types
+                                      , size_t numTypes
+                                      , /*(OUT, LibLLVMTypeLayout[numTypes])*/ LibLLVMTypeLayout* layouts
+                                      )
+    {
+        if (numTypes > 0 && (types == nullptr || layouts == nullptr))
+        {
+            return LLVMCreateStringError("types or layouts array is null");
+        }
+
+        return WithQueryLayout(*unwrap(dataLayout), [&](DataLayout const& layout) -> LLVMErrorRef
+            {
+                for (size_t i = 0; i < numTypes; ++i)
+                {
+                    Type* pType = unwrap(types[i]);
+                    if (pType == nullptr || !pType->isSized())
+                    {
+                        return LLVMCreateStringError("types array contains a null or unsized type");
+                    }
+
+                    GetTypeLayout(layout, pType, layouts[i]);
+                }
+
+                return nullptr;
+            });
+    }
+
+    LLVMErrorRef LibLLVMGetStructLayout( LLVMTargetDataRef dataLayout
+                                       , LLVMTypeRef structType
+                                       , /*[out, byref]*/ LibLLVMTypeLayout* pLayout
+                                       , /*(OUT, uint64_t[numOffsets])*/ uint64_t* offsets
+                                       , size_t numOffsets
+                                       )
+    {
+        if (pLayout == nullptr)
+        {
+            return LLVMCreateStringError("Out ref parameter 'pLayout' is null!");
+        }
+
+        auto* pStructType = dyn_cast<StructType>(unwrap(structType));
+        if (pStructType == nullptr || !pStructType->isSized())
+        {
+            return LLVMCreateStringError("structType is not a sized struct type");
+        }
+
+        unsigned numElements = pStructType->getNumElements();
+        if (numElements > 0 && (offsets == nullptr || numOffsets < numElements))
+        {
+            return LLVMCreateStringError("offsets array is too small, use LLVMCountStructElementTypes() to get the minimum required size");
+        }
+
+        WithQueryLayout(*unwrap(dataLayout), [&](DataLayout const& layout)
+            {
+                GetTypeLayout(layout, pStructType, *pLayout);
+
+                StructLayout const* pStructLayout = layout.getStructLayout(pStructType);
+                for (unsigned i = 0; i < numElements; ++i)
+                {
+                    offsets[i] = pStructLayout->getElementOffset(i).getKnownMinValue();
+                }
+            });
+
+        return nullptr;
     }
 }
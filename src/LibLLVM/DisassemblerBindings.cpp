@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "libllvm-c/DisassemblerBindings.h"
+#include "libllvm-c/TargetRegistrationBindings.h"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/MC/MCAsmInfo.h>
+#include <llvm/MC/MCContext.h>
+#include <llvm/MC/MCDisassembler/MCDisassembler.h>
+#include <llvm/MC/MCInst.h>
+#include <llvm/MC/MCInstPrinter.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/MCTargetOptions.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/Parallel.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/TargetParser/Triple.h>
+
+using namespace llvm;
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMDisassembledInstruction>, "LibLLVMDisassembledInstruction must be blittable for stable ABI binding");
+
+    constexpr uint32_t InvalidId = UINT32_MAX;
+
+    // The target descriptions are immutable and shared by all threads. The MCContext, decoder and printer are
+    // NOT thread safe (some targets keep decoding state) so each task of a batch creates its own (see: Decoder).
+    class BatchDisassembler
+    {
+    public:
+        Triple TargetTriple;
+        Target const* TheTarget = nullptr;
+        uint32_t SyntaxVariant = 0;
+        MCTargetOptions Options;
+        std::unique_ptr<MCRegisterInfo const> MRI;
+        std::unique_ptr<MCAsmInfo const> MAI;
+        std::unique_ptr<MCSubtargetInfo const> STI;
+        std::unique_ptr<MCInstrInfo const> MII;
+
+        // Mnemonic id of each opcode and the distinct mnemonics
+        std::vector<uint32_t> OpcodeMnemonics;
+        std::vector<std::string> Mnemonics;
+
+        void BuildMnemonics(MCInstPrinter const& printer)
+        {
+            StringMap<uint32_t> ids;
+            OpcodeMnemonics.resize(MII->getNumOpcodes(), InvalidId);
+            for (uint32_t opcode = 0; opcode < MII->getNumOpcodes(); ++opcode)
+            {
+                MCInst inst;
+                inst.setOpcode(opcode);
+                char const* mnemonic = printer.getMnemonic(inst).first;
+                if (mnemonic == nullptr)
+                {
+                    continue;
+                }
+
+                // The mnemonic is the start of the asm string, including the separator from the operands
+                StringRef name = StringRef(mnemonic).trim();
+                if (name.empty())
+                {
+                    continue;
+                }
+
+                auto [it, inserted] = ids.try_emplace(name, static_cast<uint32_t>(Mnemonics.size()));
+                if (inserted)
+                {
+                    Mnemonics.push_back(name.str());
+                }
+
+                OpcodeMnemonics[opcode] = it->second;
+            }
+        }
+    };
+
+    // Thread specific state for decoding one part of a region
+    struct Decoder
+    {
+        Decoder(BatchDisassembler const& disassembler)
+            : Context(disassembler.TargetTriple, disassembler.MAI.get(), disassembler.MRI.get(), disassembler.STI.get(), nullptr, &disassembler.Options)
+        {
+            DisAsm.reset(disassembler.TheTarget->createMCDisassembler(*disassembler.STI, Context));
+            Printer.reset(disassembler.TheTarget->createMCInstPrinter(disassembler.TargetTriple, disassembler.SyntaxVariant, *disassembler.MAI, *disassembler.MII, *disassembler.MRI));
+        }
+
+        MCContext Context;
+        std::unique_ptr<MCDisassembler const> DisAsm;
+        std::unique_ptr<MCInstPrinter> Printer;
+    };
+
+    struct DisassembleResults
+    {
+        std::vector<LibLLVMDisassembledInstruction> Instructions;
+        std::string Text;
+    };
+
+    // Decodes [begin, end) of the region; offsets in the results are from the start of the region and text offsets
+    // are from the start of the text of this part.
+    void DecodeRange( BatchDisassembler const& disassembler
+                    , ArrayRef<uint8_t> region
+                    , uint64_t address
+                    , uint64_t begin
+                    , uint64_t end
+                    , LibLLVMDisassembleOptions options
+                    , DisassembleResults& results
+                    )
+    {
+        Decoder decoder(disassembler);
+        decoder.Printer->setPrintImmHex((options & LibLLVMDisassembleOptions_HexImmediates) != 0);
+        bool formatText = (options & LibLLVMDisassembleOptions_FormatText) != 0;
+        uint64_t minLength = std::max<uint64_t>(disassembler.MAI->getMinInstAlignment(), 1);
+
+        SmallString<128> text;
+        for (uint64_t offset = begin; offset < end;)
+        {
+            MCInst inst;
+            uint64_t size = 0;
+            ArrayRef<uint8_t> bytes = region.slice(offset, end - offset);
+            auto status = decoder.DisAsm->getInstruction(inst, size, bytes, address + offset, nulls());
+
+            LibLLVMDisassembledInstruction record{ offset, 0, InvalidId, InvalidId, 0, results.Text.size() };
+            if (status == MCDisassembler::Fail || size == 0)
+            {
+                size = std::min(std::max(size, minLength), end - offset);
+            }
+            else
+            {
+                record.Opcode = inst.getOpcode();
+                record.MnemonicId = record.Opcode < disassembler.OpcodeMnemonics.size() ? disassembler.OpcodeMnemonics[record.Opcode] : InvalidId;
+                if (formatText)
+                {
+                    text.clear();
+                    raw_svector_ostream os(text);
+                    decoder.Printer->printInst(&inst, address + offset, StringRef(), *disassembler.STI, os);
+                    StringRef trimmed = text.str().ltrim();
+                    results.Text.append(trimmed.data(), trimmed.size());
+                    record.TextLength = static_cast<uint32_t>(trimmed.size());
+                }
+            }
+
+            record.Length = static_cast<uint32_t>(size);
+            results.Instructions.push_back(record);
+            offset += size;
+        }
+    }
+
+    // Splits the region into parts that start at function boundaries, with roughly the same size for each thread
+    std::vector<uint64_t> GetPartStarts( uint64_t numBytes, ArrayRef<uint64_t> functionOffsets )
+    {
+        std::vector<uint64_t> starts{ 0 };
+        uint64_t numThreads = std::max<uint64_t>(hardware_concurrency().compute_thread_count(), 1);
+        uint64_t targetSize = std::max<uint64_t>(numBytes / numThreads, 1);
+        for (uint64_t offset : functionOffsets)
+        {
+            if (offset - starts.back() >= targetSize)
+            {
+                starts.push_back(offset);
+            }
+        }
+
+        return starts;
+    }
+
+    inline BatchDisassembler* unwrap(LibLLVMBatchDisassemblerRef disassembler)
+    {
+        return reinterpret_cast<BatchDisassembler*>(disassembler);
+    }
+
+    inline LibLLVMBatchDisassemblerRef wrap(BatchDisassembler* disassembler)
+    {
+        return reinterpret_cast<LibLLVMBatchDisassemblerRef>(disassembler);
+    }
+
+    inline DisassembleResults* unwrap(LibLLVMDisassembleResultsRef results)
+    {
+        return reinterpret_cast<DisassembleResults*>(results);
+    }
+
+    inline LibLLVMDisassembleResultsRef wrap(DisassembleResults* results)
+    {
+        return reinterpret_cast<LibLLVMDisassembleResultsRef>(results);
+    }
+}
+
+extern "C"
+{
+    LLVMErrorRef LibLLVMCreateBatchDisassembler( char const* triple
+                                               , size_t tripleLen
+                                               , char const* cpu
+                                               , size_t cpuLen
+                                               , char const* features
+                                               , size_t featuresLen
+                                               , uint32_t syntaxVariant
+                                               , LibLLVMBatchDisassemblerRef* outRetVal
+                                               )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        if (triple == nullptr || tripleLen == 0)
+        {
+            return LLVMCreateStringError("triple is null or empty");
+        }
+
+        std::string tripleStr(triple, tripleLen);
+        std::string cpuStr = cpu == nullptr ? std::string() : std::string(cpu, cpuLen);
+        std::string featuresStr = features == nullptr ? std::string() : std::string(features, featuresLen);
+
+        // Complete a lazy registration of the disassembler; an unknown target is reported by the lookup
+        LLVMConsumeError(LibLLVMRegisterPendingTargetForTriple(triple, tripleLen, TargetRegistration_Disassembler));
+
+        std::string errMsg;
+        Target const* target = TargetRegistry::lookupTarget(tripleStr, errMsg);
+        if (target == nullptr)
+        {
+            return LLVMCreateStringError(errMsg.c_str());
+        }
+
+        auto retVal = std::make_unique<BatchDisassembler>();
+        retVal->TargetTriple = Triple(tripleStr);
+        retVal->TheTarget = target;
+        retVal->SyntaxVariant = syntaxVariant;
+        retVal->MRI.reset(target->createMCRegInfo(tripleStr));
+        if (!retVal->MRI)
+        {
+            return LLVMCreateStringError("Unable to create register info for the target");
+        }
+
+        retVal->MAI.reset(target->createMCAsmInfo(*retVal->MRI, tripleStr, retVal->Options));
+        if (!retVal->MAI)
+        {
+            return LLVMCreateStringError("Unable to create asm info for the target");
+        }
+
+        retVal->STI.reset(target->createMCSubtargetInfo(tripleStr, cpuStr, featuresStr));
+        if (!retVal->STI)
+        {
+            return LLVMCreateStringError("Unable to create subtarget info for the target");
+        }
+
+        retVal->MII.reset(target->createMCInstrInfo());
+        if (!retVal->MII)
+        {
+            return LLVMCreateStringError("Unable to create instruction info for the target");
+        }
+
+        // Validate the thread specific parts can be created so that a batch never fails to create them
+        Decoder decoder(*retVal);
+        if (!decoder.DisAsm)
+        {
+            return LLVMCreateStringError("Unable to create a disassembler for the target; is the disassembler registered?");
+        }
+
+        if (!decoder.Printer)
+        {
+            return LLVMCreateStringError("Unable to create an instruction printer for the target and syntax variant");
+        }
+
+        retVal->BuildMnemonics(*decoder.Printer);
+        *outRetVal = wrap(retVal.release());
+        return nullptr;
+    }
+
+    void LibLLVMDisposeBatchDisassembler( LibLLVMBatchDisassemblerRef disassembler )
+    {
+        delete unwrap(disassembler);
+    }
+
+    char const* LibLLVMBatchDisassemblerGetOpcodeName( LibLLVMBatchDisassemblerRef disassembler, uint32_t opcode, size_t* len )
+    {
+        MCInstrInfo const& mii = *unwrap(disassembler)->MII;
+        if (opcode >= mii.getNumOpcodes())
+        {
+            *len = 0;
+            return nullptr;
+        }
+
+        StringRef name = mii.getName(opcode);
+        *len = name.size();
+        return name.data();
+    }
+
+    uint32_t LibLLVMBatchDisassemblerGetNumMnemonics( LibLLVMBatchDisassemblerRef disassembler )
+    {
+        return static_cast<uint32_t>(unwrap(disassembler)->Mnemonics.size());
+    }
+
+    char const* LibLLVMBatchDisassemblerGetMnemonic( LibLLVMBatchDisassemblerRef disassembler, uint32_t mnemonicId, size_t* len )
+    {
+        BatchDisassembler const& self = *unwrap(disassembler);
+        if (mnemonicId >= self.Mnemonics.size())
+        {
+            *len = 0;
+            return nullptr;
+        }
+
+        *len = self.Mnemonics[mnemonicId].size();
+        return self.Mnemonics[mnemonicId].data();
+    }
+
+    LLVMErrorRef LibLLVMBatchDisassemble( LibLLVMBatchDisassemblerRef disassembler
+                                        , uint8_t const* bytes
+                                        , uint64_t numBytes
+                                        , uint64_t address
+                                        , uint64_t const* functionOffsets
+                                        , size_t numFunctionOffsets
+                                        , LibLLVMDisassembleOptions options
+                                        , LibLLVMDisassembleResultsRef* outResults
+                                        )
+    {
+        if (outResults == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outResults' is null!");
+        }
+
+        *outResults = nullptr;
+        if (bytes == nullptr && numBytes > 0)
+        {
+            return LLVMCreateStringError("bytes is null");
+        }
+
+        if (functionOffsets == nullptr && numFunctionOffsets > 0)
+        {
+            return LLVMCreateStringError("functionOffsets is null");
+        }
+
+        ArrayRef<uint64_t> offsets(functionOffsets, numFunctionOffsets);
+        for (size_t i = 0; i < offsets.size(); ++i)
+        {
+            if (offsets[i] >= numBytes || (i > 0 && offsets[i] <= offsets[i - 1]))
+            {
+                return LLVMCreateStringError("Function offsets must be sorted, distinct and within the region");
+            }
+        }
+
+        BatchDisassembler const& self = *unwrap(disassembler);
+        ArrayRef<uint8_t> region(bytes, static_cast<size_t>(numBytes));
+        std::vector<uint64_t> starts = GetPartStarts(numBytes, offsets);
+        std::vector<DisassembleResults> parts(starts.size());
+        parallelFor(0, starts.size(), [&](size_t i)
+            {
+                uint64_t end = i + 1 < starts.size() ? starts[i + 1] : numBytes;
+                DecodeRange(self, region, address, starts[i], end, options, parts[i]);
+            });
+
+        // Merge the parts in order, adjusting the text offsets for the text of the previous parts
+        auto results = std::make_unique<DisassembleResults>();
+        size_t numInstructions = 0;
+        size_t textSize = 0;
+        for (DisassembleResults const& part : parts)
+        {
+            numInstructions += part.Instructions.size();
+            textSize += part.Text.size();
+        }
+
+        results->Instructions.reserve(numInstructions);
+        results->Text.reserve(textSize);
+        for (DisassembleResults const& part : parts)
+        {
+            uint64_t textBase = results->Text.size();
+            for (LibLLVMDisassembledInstruction record : part.Instructions)
+            {
+                record.TextOffset += textBase;
+                results->Instructions.push_back(record);
+            }
+
+            results->Text.append(part.Text);
+        }
+
+        *outResults = wrap(results.release());
+        return nullptr;
+    }
+
+    void LibLLVMDisposeDisassembleResults( LibLLVMDisassembleResultsRef results )
+    {
+        delete unwrap(results);
+    }
+
+    LibLLVMDisassembledInstruction const* LibLLVMDisassembleResultsGetInstructions( LibLLVMDisassembleResultsRef results, size_t* numInstructions )
+    {
+        *numInstructions = unwrap(results)->Instructions.size();
+        return unwrap(results)->Instructions.data();
+    }
+
+    char const* LibLLVMDisassembleResultsGetText( LibLLVMDisassembleResultsRef results, size_t* len )
+    {
+        *len = unwrap(results)->Text.size();
+        return unwrap(results)->Text.data();
+    }
+}
@@ -0,0 +1,21 @@
+#include <llvm-c/Target.h>
+
+// Reduced footprint builds of this library exclude the target specific assembly parser and/or
+// disassembler libraries from the link (see: LibLLVMExcludedComponents in LibLLVM.vcxproj).
+// Target registration still references the initialization functions of those libraries, so
+// this provides NOP stubs for each configured target to satisfy the linker. Registration of an
+// excluded kind is masked off so it is never reported as registered.
+// (see: LibLLVMGetAvailableTargetRegistrations())
+
+extern "C"
+{
+#if LIBLLVM_EXCLUDE_ASMPARSER
+#define LLVM_ASM_PARSER(TargetName) void LLVMInitialize##TargetName##AsmParser(void) { }
+#include <llvm/Config/AsmParsers.def>
+#endif
+
+#if LIBLLVM_EXCLUDE_DISASSEMBLER
+#define LLVM_DISASSEMBLER(TargetName) void LLVMInitialize##TargetName##Disassembler(void) { }
+#include <llvm/Config/Disassemblers.def>
+#endif
+}
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "libllvm-c/HostCpuBindings.h"
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/Error.h>
+#include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/Triple.h>
+
+using namespace llvm;
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMNativeTargetMachineOptions>, "LibLLVMNativeTargetMachineOptions must be blittable for stable ABI binding");
+
+    struct HostCpu
+    {
+        std::string Triple;
+        std::string Name;
+        std::string Features;
+
+        // Constant table generated for the target, sorted by name; Value of each entry is its bit index
+        ArrayRef<SubtargetFeatureKV> FeatureTable;
+
+        // Names indexed by bit index (the table is not required to be in bit order)
+        std::vector<StringRef> FeatureNames;
+        std::vector<uint64_t> FeatureBits;
+    };
+
+    SubtargetFeatureKV const* FindFeature(ArrayRef<SubtargetFeatureKV> table, StringRef name)
+    {
+        auto it = llvm::lower_bound(table, name, [](SubtargetFeatureKV const& kv, StringRef name) { return StringRef(kv.Key) < name; });
+        return it != table.end() && StringRef(it->Key) == name ? it : nullptr;
+    }
+
+    Expected<std::unique_ptr<HostCpu>> DetectHostCpu()
+    {
+        auto host = std::make_unique<HostCpu>();
+        host->Triple = Triple::normalize(sys::getProcessTriple());
+        host->Name = sys::getHostCPUName().str();
+
+        std::string errMsg;
+        Target const* target = TargetRegistry::lookupTarget(host->Triple, errMsg);
+        if (target == nullptr)
+        {
+            return createStringError(inconvertibleErrorCode(), errMsg.c_str());
+        }
+
+        std::unique_ptr<MCSubtargetInfo> sti(target->createMCSubtargetInfo(host->Triple, host->Name, StringRef()));
+        if (!sti)
+        {
+            return createStringError(inconvertibleErrorCode(), "Unable to create subtarget info for the target");
+        }
+
+        host->FeatureTable = sti->getAllProcessorFeatures();
+        uint32_t numFeatures = 0;
+        for (SubtargetFeatureKV const& kv : host->FeatureTable)
+        {
+            numFeatures = std::max(numFeatures, kv.Value + 1);
+        }
+
+        host->FeatureNames.resize(numFeatures);
+        for (SubtargetFeatureKV const& kv : host->FeatureTable)
+        {
+            host->FeatureNames[kv.Value] = kv.Key;
+        }
+
+        // Only the features the target knows are kept, otherwise every use of the string reports the unknown
+        // ones as an error. The map is unordered so the names are sorted to make the string canonical.
+        std::vector<std::string> flags;
+        for (auto const& [name, enabled] : sys::getHostCPUFeatures())
+        {
+            if (FindFeature(host->FeatureTable, name) != nullptr)
+            {
+                flags.push_back((enabled ? "+" : "-") + name.str());
+            }
+        }
+
+        llvm::sort(flags, [](std::string const& lhs, std::string const& rhs) { return StringRef(lhs).drop_front() < StringRef(rhs).drop_front(); });
+        host->Features = join(flags, ",");
+
+        // Applying the features to the CPU also enables every feature they imply
+        sti->setDefaultFeatures(host->Name, host->Name, host->Features);
+        FeatureBitset const& bits = sti->getFeatureBits();
+        host->FeatureBits.resize((numFeatures + 63) / 64);
+        for (uint32_t i = 0; i < numFeatures; ++i)
+        {
+            if (bits.test(i))
+            {
+                host->FeatureBits[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+
+        return std::move(host);
+    }
+
+    Expected<HostCpu const*> GetHostCpu()
+    {
+        // Only a successful detection is kept so a failure (i.e. native target not registered yet) is retried
+        static std::mutex hostLock;
+        static std::unique_ptr<HostCpu> host;
+
+        std::lock_guard<std::mutex> lock(hostLock);
+        if (!host)
+        {
+            Expected<std::unique_ptr<HostCpu>> detected = DetectHostCpu();
+            if (!detected)
+            {
+                return detected.takeError();
+            }
+
+            host = std::move(*detected);
+        }
+
+        return host.get();
+    }
+
+    inline HostCpu const* unwrap(LibLLVMHostCpuRef host)
+    {
+        return reinterpret_cast<HostCpu const*>(host);
+    }
+
+    inline LibLLVMHostCpuRef wrap(HostCpu const* host)
+    {
+        return reinterpret_cast<LibLLVMHostCpuRef>(const_cast<HostCpu*>(host));
+    }
+
+    inline char const* GetString(std::string const& str, size_t* len)
+    {
+        *len = str.size();
+        return str.c_str();
+    }
+}
+
+extern "C"
+{
+    LLVMErrorRef LibLLVMGetHostCpu( LibLLVMHostCpuRef* outRetVal )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        Expected<HostCpu const*> host = GetHostCpu();
+        if (!host)
+        {
+            return wrap(host.takeError());
+        }
+
+        *outRetVal = wrap(*host);
+        return nullptr;
+    }
+
+    char const* LibLLVMHostCpuGetTriple( LibLLVMHostCpuRef host, size_t* len )
+    {
+        return GetString(unwrap(host)->Triple, len);
+    }
+
+    char const* LibLLVMHostCpuGetName( LibLLVMHostCpuRef host, size_t* len )
+    {
+        return GetString(unwrap(host)->Name, len);
+    }
+
+    char const* LibLLVMHostCpuGetFeatures( LibLLVMHostCpuRef host, size_t* len )
+    {
+        return GetString(unwrap(host)->Features, len);
+    }
+
+    uint32_t LibLLVMHostCpuGetNumFeatures( LibLLVMHostCpuRef host )
+    {
+        return static_cast<uint32_t>(unwrap(host)->FeatureNames.size());
+    }
+
+    char const* LibLLVMHostCpuGetFeatureName( LibLLVMHostCpuRef host, uint32_t index, size_t* len )
+    {
+        std::vector<StringRef> const& names = unwrap(host)->FeatureNames;
+        if (index >= names.size())
+        {
+            *len = 0;
+            return nullptr;
+        }
+
+        *len = names[index].size();
+        return names[index].data();
+    }
+
+    uint32_t LibLLVMHostCpuFindFeature( LibLLVMHostCpuRef host, char const* name, size_t nameLen )
+    {
+        if (name == nullptr)
+        {
+            return UINT32_MAX;
+        }
+
+        SubtargetFeatureKV const* feature = FindFeature(unwrap(host)->FeatureTable, StringRef(name, nameLen));
+        return feature == nullptr ? UINT32_MAX : feature->Value;
+    }
+
+    LLVMBool LibLLVMHostCpuHasFeature( LibLLVMHostCpuRef host, uint32_t index )
+    {
+        std::vector<uint64_t> const& bits = unwrap(host)->FeatureBits;
+        return index / 64 < bits.size() && (bits[index / 64] & (uint64_t(1) << (index % 64))) != 0;
+    }
+
+    uint32_t LibLLVMHostCpuGetNumFeatureWords( LibLLVMHostCpuRef host )
+    {
+        return static_cast<uint32_t>(unwrap(host)->FeatureBits.size());
+    }
+
+    LLVMErrorRef LibLLVMHostCpuGetFeatureBits( LibLLVMHostCpuRef host, uint64_t* words, uint32_t numWords )
+    {
+        std::vector<uint64_t> const& bits = unwrap(host)->FeatureBits;
+        if (numWords < bits.size())
+        {
+            return LLVMCreateStringError("numWords is less than the number of words in the feature bits");
+        }
+
+        if (words == nullptr && numWords > 0)
+        {
+            return LLVMCreateStringError("words is null");
+        }
+
+        std::fill(std::copy(bits.begin(), bits.end(), words), words + numWords, 0);
+        return nullptr;
+    }
+
+    void LibLLVMHostCpuGetNativeTargetMachineOptions( LibLLVMHostCpuRef host
+                                                    , LLVMCodeGenOptLevel optLevel
+                                                    , LibLLVMNativeTargetMachineOptions* options
+                                                    )
+    {
+        HostCpu const& cpu = *unwrap(host);
+        *options = LibLLVMNativeTargetMachineOptions{ cpu.Triple.c_str()
+                                                    , cpu.Triple.size()
+                                                    , cpu.Name.c_str()
+                                                    , cpu.Name.size()
+                                                    , cpu.Features.c_str()
+                                                    , cpu.Features.size()
+                                                    , optLevel
+                                                    , LLVMRelocDefault
+                                                    , LLVMCodeModelJITDefault
+                                                    };
+    }
+
+    LLVMTargetMachineOptionsRef LibLLVMCreateNativeTargetMachineOptions( LibLLVMNativeTargetMachineOptions const* options )
+    {
+        if (options == nullptr)
+        {
+            return nullptr;
+        }
+
+        // The LLVM-C setters need nul terminated strings and the strings of the struct are not required to be
+        std::string cpu(options->CPU, options->CPULen);
+        std::string features(options->Features, options->FeaturesLen);
+
+        LLVMTargetMachineOptionsRef retVal = LLVMCreateTargetMachineOptions();
+        LLVMTargetMachineOptionsSetCPU(retVal, cpu.c_str());
+        LLVMTargetMachineOptionsSetFeatures(retVal, features.c_str());
+        LLVMTargetMachineOptionsSetCodeGenOptLevel(retVal, options->OptLevel);
+        LLVMTargetMachineOptionsSetRelocMode(retVal, options->RelocMode);
+        LLVMTargetMachineOptionsSetCodeModel(retVal, options->CodeModel);
+        return retVal;
+    }
+}
@@ -1,12 +1,127 @@
+#include <cstdint>
+#include <type_traits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "libllvm-c/ObjectFileBindings.h"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Sequence.h"
+#include "llvm/BinaryFormat/Magic.h"
+#include "llvm/Object/Archive.h"
+#include "llvm/Object/Binary.h"
+#include "llvm/Object/COFFImportFile.h"
+#include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Object/ObjectFile.h"
+#include "llvm/Object/SymbolSize.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 
 using namespace llvm;
 using namespace object;
 
 namespace
 {
+    static_assert(std::is_trivially_copyable_v<LibLLVMObjectSymbol>, "LibLLVMObjectSymbol must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMObjectRelocation>, "LibLLVMObjectRelocation must be blittable for stable ABI binding");
+
+#define ASSERT_FLAG_MATCH(NAME) \
+    static_assert(static_cast<uint32_t>(LibLLVMObjectSymbolFlags_##NAME) == static_cast<uint32_t>(BasicSymbolRef::SF_##NAME), "LibLLVMObjectSymbolFlags_" #NAME " does not match LLVM")
+
+    ASSERT_FLAG_MATCH(Undefined);
+    ASSERT_FLAG_MATCH(Global);
+    ASSERT_FLAG_MATCH(Weak);
+    ASSERT_FLAG_MATCH(Absolute);
+    ASSERT_FLAG_MATCH(Common);
+    ASSERT_FLAG_MATCH(Indirect);
+    ASSERT_FLAG_MATCH(Exported);
+    ASSERT_FLAG_MATCH(FormatSpecific);
+    ASSERT_FLAG_MATCH(Thumb);
+    ASSERT_FLAG_MATCH(Hidden);
+    ASSERT_FLAG_MATCH(Const);
+    ASSERT_FLAG_MATCH(Executable);
+#undef ASSERT_FLAG_MATCH
+
+    static_assert(static_cast<int>(LibLLVMObjectSymbolType_Unknown) == static_cast<int>(SymbolRef::ST_Unknown), "LibLLVMObjectSymbolType does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMObjectSymbolType_Data) == static_cast<int>(SymbolRef::ST_Data), "LibLLVMObjectSymbolType does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMObjectSymbolType_Debug) == static_cast<int>(SymbolRef::ST_Debug), "LibLLVMObjectSymbolType does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMObjectSymbolType_File) == static_cast<int>(SymbolRef::ST_File), "LibLLVMObjectSymbolType does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMObjectSymbolType_Function) == static_cast<int>(SymbolRef::ST_Function), "LibLLVMObjectSymbolType does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMObjectSymbolType_Other) == static_cast<int>(SymbolRef::ST_Other), "LibLLVMObjectSymbolType does not match LLVM");
+
+    constexpr uint32_t NoSectionIndex = UINT32_MAX;
+    constexpr uint32_t NoSymbolIndex = UINT32_MAX;
+    constexpr uint32_t NoMemberIndex = UINT32_MAX;
+
+    // Key for the raw reference of a symbol; Uses both halves of the reference as some formats (i.e. ELF)
+    // use the upper half for the index and hashing a pointer sized value only uses the lower half.
+    using SymbolKey = std::pair<uint32_t, uint32_t>;
+
+    inline SymbolKey GetSymbolKey( DataRefImpl ref )
+    {
+        return { ref.d.a, ref.d.b };
+    }
+
+    // The buffer is opened without requiring a nul terminator, which allows MemoryBuffer to map the
+    // file instead of reading (copying) it into an allocated buffer.
+    struct MappedObjectFile
+    {
+        std::unique_ptr<MemoryBuffer> Buffer;   // null for members of an archive, which own the mapping
+        std::unique_ptr<ObjectFile> Object;
+        std::vector<SectionRef> Sections;   // Random access to sections for parallel scans
+        uint64_t NumSymbols = 0;
+        uint64_t NumDynamicSymbols = 0;
+
+        // Maps the raw reference of a symbol to its index in the symbol table; Built on first use by
+        // a relocation scan as most uses of an object never need it.
+        std::once_flag SymbolIndicesBuilt;
+        DenseMap<SymbolKey, uint32_t> SymbolIndices;
+        DenseMap<SymbolKey, uint32_t> DynamicSymbolIndices;
+
+        void BuildSymbolIndices()
+        {
+            std::call_once(SymbolIndicesBuilt, [this]()
+                {
+                    SymbolIndices.reserve(static_cast<unsigned>(NumSymbols));
+                    AddSymbolIndices(Object->symbols(), SymbolIndices);
+                    if (auto* elf = dyn_cast<ELFObjectFileBase>(Object.get()))
+                    {
+                        DynamicSymbolIndices.reserve(static_cast<unsigned>(NumDynamicSymbols));
+                        AddSymbolIndices(elf->getDynamicSymbolIterators(), DynamicSymbolIndices);
+                    }
+                });
+        }
+
+    private:
+        template<typename TRange>
+        static void AddSymbolIndices( TRange&& symbols, DenseMap<SymbolKey, uint32_t>& indices )
+        {
+            uint32_t index = 0;
+            for (auto it = symbols.begin(); it != symbols.end(); ++it)
+            {
+                indices.try_emplace(GetSymbolKey(it->getRawDataRefImpl()), index++);
+            }
+        }
+    };
+
+    // The symbol index of the archive is read once when the archive is opened; members are parsed into
+    // object files on first use (or all at once in parallel) and the objects are owned by the archive as
+    // they refer to the mapping of the archive.
+    struct MappedArchive
+    {
+        std::unique_ptr<MemoryBuffer> Buffer;
+        std::unique_ptr<Archive> Library;
+        std::vector<Archive::Child> Members;
+        std::vector<StringRef> MemberNames;
+        DenseMap<StringRef, uint32_t> SymbolMembers;
+
+        std::mutex Lock;
+        std::vector<LibLLVMArchiveMemberKind> MemberKinds;
+        std::vector<std::unique_ptr<MappedObjectFile>> Objects;
+    };
+
     inline symbol_iterator* unwrap( LLVMSymbolIteratorRef SI )
     {
         return reinterpret_cast< symbol_iterator* >( SI );
@@ -36,6 +151,206 @@ namespace
     {
         return reinterpret_cast< LLVMRelocationIteratorRef >( const_cast< relocation_iterator* >( SI ) );
     }
+
+    inline MappedObjectFile* unwrap( LibLLVMMappedObjectFileRef objFile )
+    {
+        return reinterpret_cast< MappedObjectFile* >( objFile );
+    }
+
+    inline LibLLVMMappedObjectFileRef wrap( MappedObjectFile* objFile )
+    {
+        return reinterpret_cast< LibLLVMMappedObjectFileRef >( objFile );
+    }
+
+    inline MappedArchive* unwrap( LibLLVMMappedArchiveRef archive )
+    {
+        return reinterpret_cast< MappedArchive* >( archive );
+    }
+
+    inline LibLLVMMappedArchiveRef wrap( MappedArchive* archive )
+    {
+        return reinterpret_cast< LibLLVMMappedArchiveRef >( archive );
+    }
+
+    template<typename TRange>
+    uint64_t CountSymbols( TRange&& symbols )
+    {
+        uint64_t count = 0;
+        for (auto it = symbols.begin(); it != symbols.end(); ++it)
+        {
+            ++count;
+        }
+
+        return count;
+    }
+
+    Error GetSymbol( ObjectFile const& obj, SymbolRef const& sym, uint64_t size, LibLLVMObjectSymbol& result )
+    {
+        Expected<StringRef> name = sym.getName();
+        if (!name)
+        {
+            return name.takeError();
+        }
+
+        Expected<uint64_t> address = sym.getAddress();
+        if (!address)
+        {
+            return address.takeError();
+        }
+
+        Expected<uint32_t> flags = sym.getFlags();
+        if (!flags)
+        {
+            return flags.takeError();
+        }
+
+        Expected<SymbolRef::Type> type = sym.getType();
+        if (!type)
+        {
+            return type.takeError();
+        }
+
+        Expected<section_iterator> section = sym.getSection();
+        if (!section)
+        {
+            return section.takeError();
+        }
+
+        result.Name = name->data();
+        result.NameLen = name->size();
+        result.Address = *address;
+        result.Size = size;
+        result.SectionIndex = *section == obj.section_end() ? NoSectionIndex : static_cast<uint32_t>((*section)->getIndex());
+        result.Flags = *flags;
+        result.Type = static_cast<LibLLVMObjectSymbolType>(*type);
+        return Error::success();
+    }
+
+    std::unique_ptr<MappedObjectFile> CreateMappedObjectFile( std::unique_ptr<ObjectFile> obj )
+    {
+        auto retVal = std::make_unique<MappedObjectFile>();
+        retVal->Object = std::move(obj);
+        retVal->NumSymbols = CountSymbols(retVal->Object->symbols());
+        for (SectionRef const& section : retVal->Object->sections())
+        {
+            retVal->Sections.push_back(section);
+        }
+
+        if (auto* elf = dyn_cast<ELFObjectFileBase>(retVal->Object.get()))
+        {
+            retVal->NumDynamicSymbols = CountSymbols(elf->getDynamicSymbolIterators());
+        }
+
+        return retVal;
+    }
+
+    // Getting the buffer of a member of a thin archive opens the member file and appends it to the buffers owned
+    // by the archive, so it MUST NOT run concurrently with itself; callers get it under the lock of the archive.
+    Expected<MemoryBufferRef> GetArchiveMemberBuffer( MappedArchive const& archive, uint32_t index )
+    {
+        Expected<MemoryBufferRef> buffer = archive.Members[index].getMemoryBufferRef();
+        if (!buffer)
+        {
+            return createFileError(archive.MemberNames[index], buffer.takeError());
+        }
+
+        return buffer;
+    }
+
+    // Opens a member as a binary, as a linker does, so that a member that is not an object file (i.e. the short
+    // import members of a COFF import library) is classified instead of failing. Only object files are kept; the
+    // kind of each member is recorded so that it is only opened once.
+    Error OpenArchiveMember( MappedArchive& archive, uint32_t index, MemoryBufferRef buffer )
+    {
+        // Opening bitcode as a binary requires an LLVMContext; as it is never an object file it is only classified
+        if (identify_magic(buffer.getBuffer()) == file_magic::bitcode)
+        {
+            archive.MemberKinds[index] = LibLLVMArchiveMemberKind_Bitcode;
+            return Error::success();
+        }
+
+        Expected<std::unique_ptr<Binary>> binary = createBinary(buffer);
+        if (!binary)
+        {
+            return createFileError(archive.MemberNames[index], binary.takeError());
+        }
+
+        if (!isa<ObjectFile>(binary->get()))
+        {
+            archive.MemberKinds[index] = isa<COFFImportFile>(binary->get()) ? LibLLVMArchiveMemberKind_ShortImport : LibLLVMArchiveMemberKind_Other;
+            return Error::success();
+        }
+
+        archive.Objects[index] = CreateMappedObjectFile(std::unique_ptr<ObjectFile>(cast<ObjectFile>(binary->release())));
+        archive.MemberKinds[index] = LibLLVMArchiveMemberKind_Object;
+        return Error::success();
+    }
+
+    // Callers hold the lock of the archive (see: GetArchiveMemberBuffer())
+    Error EnsureArchiveMemberOpened( MappedArchive& archive, uint32_t index )
+    {
+        if (archive.MemberKinds[index] != LibLLVMArchiveMemberKind_NotOpened)
+        {
+            return Error::success();
+        }
+
+        Expected<MemoryBufferRef> buffer = GetArchiveMemberBuffer(archive, index);
+        if (!buffer)
+        {
+            return buffer.takeError();
+        }
+
+        return OpenArchiveMember(archive, index, *buffer);
+    }
+
+    void GetRelocation( MappedObjectFile const& mapped, bool hasAddend, RelocationRef const& rel, LibLLVMObjectRelocation& result )
+    {
+        result.Offset = rel.getOffset();
+        result.Type = rel.getType();
+        result.Addend = 0;
+        result.SymbolIndex = NoSymbolIndex;
+        result.SymbolIsDynamic = false;
+
+        if (hasAddend)
+        {
+            Expected<int64_t> addend = ELFRelocationRef(rel).getAddend();
+            if (addend)
+            {
+                result.Addend = *addend;
+            }
+            else
+            {
+                consumeError(addend.takeError());
+            }
+        }
+
+        symbol_iterator sym = rel.getSymbol();
+        if (sym == mapped.Object->symbol_end())
+        {
+            return;
+        }
+
+        SymbolKey key = GetSymbolKey(sym->getRawDataRefImpl());
+        auto it = mapped.SymbolIndices.find(key);
+        if (it != mapped.SymbolIndices.end())
+        {
+            result.SymbolIndex = it->second;
+            return;
+        }
+
+        it = mapped.DynamicSymbolIndices.find(key);
+        if (it != mapped.DynamicSymbolIndices.end())
+        {
+            result.SymbolIndex = it->second;
+            result.SymbolIsDynamic = true;
+        }
+    }
+
+    // Only ELF has explicit addends, and then only for sections that are not SHT_REL
+    bool HasAddends( SectionRef const& section )
+    {
+        return isa<ELFObjectFileBase>(section.getObject()) && ELFSectionRef(section).getType() != ELF::SHT_REL;
+    }
 }
 
 extern "C"
@@ -54,4 +369,369 @@ extern "C"
     {
         return wrap( new relocation_iterator( *unwrap( ref ) ) );
     }
+
+    LLVMErrorRef LibLLVMOpenMappedObjectFile( char const* path, size_t pathLen, LibLLVMMappedObjectFileRef* outRetVal )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        if (path == nullptr || pathLen == 0)
+        {
+            return LLVMCreateStringError("path is null or empty");
+        }
+
+        StringRef pathRef(path, pathLen);
+        ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFile(pathRef, /*IsText*/ false, /*RequiresNullTerminator*/ false);
+        if (!buffer)
+        {
+            return wrap(createFileError(pathRef, buffer.getError()));
+        }
+
+        Expected<std::unique_ptr<ObjectFile>> obj = ObjectFile::createObjectFile((*buffer)->getMemBufferRef());
+        if (!obj)
+        {
+            return wrap(createFileError(pathRef, obj.takeError()));
+        }
+
+        auto retVal = CreateMappedObjectFile(std::move(*obj));
+        retVal->Buffer = std::move(*buffer);
+        *outRetVal = wrap(retVal.release());
+        return nullptr;
+    }
+
+    void LibLLVMDisposeMappedObjectFile( LibLLVMMappedObjectFileRef objFile )
+    {
+        delete unwrap(objFile);
+    }
+
+    LLVMBinaryRef LibLLVMMappedObjectFileGetBinary( LibLLVMMappedObjectFileRef objFile )
+    {
+        return reinterpret_cast<LLVMBinaryRef>(static_cast<Binary*>(unwrap(objFile)->Object.get()));
+    }
+
+    uint64_t LibLLVMMappedObjectFileGetNumSymbols( LibLLVMMappedObjectFileRef objFile, LLVMBool dynamic )
+    {
+        return dynamic ? unwrap(objFile)->NumDynamicSymbols : unwrap(objFile)->NumSymbols;
+    }
+
+    LLVMErrorRef LibLLVMMappedObjectFileGetSymbols( LibLLVMMappedObjectFileRef objFile
+                                                  , LLVMBool dynamic
+                                                  , LibLLVMObjectSymbol* symbols
+                                                  , uint64_t numSymbols
+                                                  )
+    {
+        MappedObjectFile const& mapped = *unwrap(objFile);
+        if (numSymbols < (dynamic ? mapped.NumDynamicSymbols : mapped.NumSymbols))
+        {
+            return LLVMCreateStringError("Symbols array is too small, use LibLLVMMappedObjectFileGetNumSymbols() to get the minimum required size");
+        }
+
+        if (symbols == nullptr && numSymbols > 0)
+        {
+            return LLVMCreateStringError("symbols is null");
+        }
+
+        ObjectFile const& obj = *mapped.Object;
+
+        // ELF has the size of each symbol in the symbol table; other formats require computing it from
+        // the addresses of the symbols (see: llvm-symbolizer and llvm-nm for the same treatment)
+        if (auto const* elf = dyn_cast<ELFObjectFileBase>(&obj))
+        {
+            uint64_t i = 0;
+            for (ELFSymbolRef sym : dynamic ? elf->getDynamicSymbolIterators() : elf->symbols())
+            {
+                if (Error err = GetSymbol(obj, sym, sym.getSize(), symbols[i++]))
+                {
+                    return wrap(std::move(err));
+                }
+            }
+
+            return nullptr;
+        }
+
+        if (dynamic)
+        {
+            // No dynamic symbols for anything other than ELF
+            return nullptr;
+        }
+
+        uint64_t i = 0;
+        for (auto const& [sym, size] : computeSymbolSizes(obj))
+        {
+            if (Error err = GetSymbol(obj, sym, size, symbols[i++]))
+            {
+                return wrap(std::move(err));
+            }
+        }
+
+        return nullptr;
+    }
+
+    uint32_t LibLLVMMappedObjectFileGetNumSections( LibLLVMMappedObjectFileRef objFile )
+    {
+        return static_cast<uint32_t>(unwrap(objFile)->Sections.size());
+    }
+
+    LLVMErrorRef LibLLVMMappedObjectFileGetRelocationCounts( LibLLVMMappedObjectFileRef objFile, uint64_t* counts, uint32_t numSections )
+    {
+        MappedObjectFile const& mapped = *unwrap(objFile);
+        if (counts == nullptr || numSections < mapped.Sections.size())
+        {
+            return LLVMCreateStringError("Counts array is too small, use LibLLVMMappedObjectFileGetNumSections() to get the minimum required size");
+        }
+
+        parallelFor(0, mapped.Sections.size(), [&](size_t i)
+            {
+                auto relocations = mapped.Sections[i].relocations();
+                counts[i] = static_cast<uint64_t>(std::distance(relocations.begin(), relocations.end()));
+            });
+
+        return nullptr;
+    }
+
+    LLVMErrorRef LibLLVMMappedObjectFileScanRelocations( LibLLVMMappedObjectFileRef objFile
+                                                       , uint64_t const* counts
+                                                       , uint32_t numSections
+                                                       , LibLLVMObjectRelocation* arena
+                                                       , uint64_t arenaLength
+                                                       )
+    {
+        MappedObjectFile& mapped = *unwrap(objFile);
+        if (counts == nullptr || numSections < mapped.Sections.size())
+        {
+            return LLVMCreateStringError("Counts array is too small, use LibLLVMMappedObjectFileGetRelocationCounts() to get the counts");
+        }
+
+        // start of the relocations of each section in the arena
+        std::vector<uint64_t> starts(mapped.Sections.size());
+        uint64_t total = 0;
+        for (size_t i = 0; i < mapped.Sections.size(); ++i)
+        {
+            starts[i] = total;
+            total += counts[i];
+        }
+
+        if (arena == nullptr || arenaLength < total)
+        {
+            return LLVMCreateStringError("Arena is too small for the sum of the relocation counts");
+        }
+
+        mapped.BuildSymbolIndices();
+        Error err = parallelForEachError(seq<uint32_t>(0, static_cast<uint32_t>(mapped.Sections.size())), [&](uint32_t i) -> Error
+            {
+                SectionRef const& section = mapped.Sections[i];
+                bool hasAddend = HasAddends(section);
+                uint64_t actual = 0;
+                for (RelocationRef const& rel : section.relocations())
+                {
+                    // never write past the space the caller provided for the section
+                    if (actual < counts[i])
+                    {
+                        GetRelocation(mapped, hasAddend, rel, arena[starts[i] + actual]);
+                    }
+
+                    ++actual;
+                }
+
+                if (actual != counts[i])
+                {
+                    return createStringError(inconvertibleErrorCode(), "Relocation count for section %u does not match the object", i);
+                }
+
+                return Error::success();
+            });
+
+        return err ? wrap(std::move(err)) : nullptr;
+    }
+
+    LLVMErrorRef LibLLVMOpenMappedArchive( char const* path, size_t pathLen, LibLLVMMappedArchiveRef* outRetVal )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        if (path == nullptr || pathLen == 0)
+        {
+            return LLVMCreateStringError("path is null or empty");
+        }
+
+        StringRef pathRef(path, pathLen);
+        ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFile(pathRef, /*IsText*/ false, /*RequiresNullTerminator*/ false);
+        if (!buffer)
+        {
+            return wrap(createFileError(pathRef, buffer.getError()));
+        }
+
+        Expected<std::unique_ptr<Archive>> archive = Archive::create((*buffer)->getMemBufferRef());
+        if (!archive)
+        {
+            return wrap(createFileError(pathRef, archive.takeError()));
+        }
+
+        auto retVal = std::make_unique<MappedArchive>();
+        retVal->Buffer = std::move(*buffer);
+        retVal->Library = std::move(*archive);
+
+        // Map the offset of each member to its index so the members of the symbol table entries are found without a scan
+        DenseMap<uint64_t, uint32_t> memberIndices;
+        Error err = Error::success();
+        for (Archive::Child const& child : retVal->Library->children(err))
+        {
+            Expected<StringRef> name = child.getName();
+            if (!name)
+            {
+                consumeError(std::move(err));
+                return wrap(createFileError(pathRef, name.takeError()));
+            }
+
+            memberIndices.try_emplace(child.getChildOffset(), static_cast<uint32_t>(retVal->Members.size()));
+            retVal->Members.push_back(child);
+            retVal->MemberNames.push_back(*name);
+        }
+
+        if (err)
+        {
+            return wrap(createFileError(pathRef, std::move(err)));
+        }
+
+        // The first member that defines a symbol wins, as it does for a linker
+        for (Archive::Symbol const& sym : retVal->Library->symbols())
+        {
+            Expected<Archive::Child> member = sym.getMember();
+            if (!member)
+            {
+                return wrap(createFileError(pathRef, member.takeError()));
+            }
+
+            auto it = memberIndices.find(member->getChildOffset());
+            if (it != memberIndices.end())
+            {
+                retVal->SymbolMembers.try_emplace(sym.getName(), it->second);
+            }
+        }
+
+        retVal->MemberKinds.resize(retVal->Members.size(), LibLLVMArchiveMemberKind_NotOpened);
+        retVal->Objects.resize(retVal->Members.size());
+        *outRetVal = wrap(retVal.release());
+        return nullptr;
+    }
+
+    void LibLLVMDisposeMappedArchive( LibLLVMMappedArchiveRef archive )
+    {
+        delete unwrap(archive);
+    }
+
+    uint32_t LibLLVMMappedArchiveGetNumMembers( LibLLVMMappedArchiveRef archive )
+    {
+        return static_cast<uint32_t>(unwrap(archive)->Members.size());
+    }
+
+    char const* LibLLVMMappedArchiveGetMemberName( LibLLVMMappedArchiveRef archive, uint32_t index, size_t* len )
+    {
+        MappedArchive const& self = *unwrap(archive);
+        if (index >= self.MemberNames.size())
+        {
+            *len = 0;
+            return nullptr;
+        }
+
+        *len = self.MemberNames[index].size();
+        return self.MemberNames[index].data();
+    }
+
+    uint64_t LibLLVMMappedArchiveGetNumSymbols( LibLLVMMappedArchiveRef archive )
+    {
+        return unwrap(archive)->SymbolMembers.size();
+    }
+
+    uint32_t LibLLVMMappedArchiveFindSymbolMember( LibLLVMMappedArchiveRef archive, char const* name, size_t nameLen )
+    {
+        MappedArchive const& self = *unwrap(archive);
+        auto it = self.SymbolMembers.find(StringRef(name, nameLen));
+        return it == self.SymbolMembers.end() ? NoMemberIndex : it->second;
+    }
+
+    LLVMErrorRef LibLLVMMappedArchiveGetMemberObject( LibLLVMMappedArchiveRef archive, uint32_t index, LibLLVMMappedObjectFileRef* outRetVal )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        MappedArchive& self = *unwrap(archive);
+        if (index >= self.Members.size())
+        {
+            return LLVMCreateStringError("Member index is out of range");
+        }
+
+        std::lock_guard<std::mutex> lock(self.Lock);
+        if (Error err = EnsureArchiveMemberOpened(self, index))
+        {
+            return wrap(std::move(err));
+        }
+
+        if (self.MemberKinds[index] != LibLLVMArchiveMemberKind_Object)
+        {
+            return wrap(createFileError(self.MemberNames[index], createStringError(inconvertibleErrorCode(), "Member is not an object file")));
+        }
+
+        *outRetVal = wrap(self.Objects[index].get());
+        return nullptr;
+    }
+
+    LibLLVMArchiveMemberKind LibLLVMMappedArchiveGetMemberKind( LibLLVMMappedArchiveRef archive, uint32_t index )
+    {
+        MappedArchive& self = *unwrap(archive);
+        if (index >= self.Members.size())
+        {
+            return LibLLVMArchiveMemberKind_NotOpened;
+        }
+
+        std::lock_guard<std::mutex> lock(self.Lock);
+        consumeError(EnsureArchiveMemberOpened(self, index));
+        return self.MemberKinds[index];
+    }
+
+    LLVMErrorRef LibLLVMMappedArchiveParseAllMembers( LibLLVMMappedArchiveRef archive )
+    {
+        MappedArchive& self = *unwrap(archive);
+        std::lock_guard<std::mutex> lock(self.Lock);
+
+        // The buffers are fetched serially first as, for a thin archive, that modifies the archive; only opening
+        // them is done in parallel. A member that fails here is not opened and its error is reported with the others.
+        std::vector<uint32_t> pending;
+        std::vector<MemoryBufferRef> buffers(self.Members.size());
+        Error err = Error::success();
+        for (uint32_t i = 0; i < self.Members.size(); ++i)
+        {
+            if (self.MemberKinds[i] != LibLLVMArchiveMemberKind_NotOpened)
+            {
+                continue;
+            }
+
+            Expected<MemoryBufferRef> buffer = GetArchiveMemberBuffer(self, i);
+            if (!buffer)
+            {
+                err = joinErrors(std::move(err), buffer.takeError());
+                continue;
+            }
+
+            buffers[i] = *buffer;
+            pending.push_back(i);
+        }
+
+        // Each task only writes the slots of its own member
+        err = joinErrors(std::move(err), parallelForEachError(pending, [&](uint32_t i) -> Error
+            {
+                return OpenArchiveMember(self, i, buffers[i]);
+            }));
+
+        return err ? wrap(std::move(err)) : nullptr;
+    }
 }
@@ -0,0 +1,210 @@
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "libllvm-c/SchedModelBindings.h"
+#include <llvm/ADT/StringMap.h>
+#include <llvm/MC/MCInstrDesc.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCSchedule.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/Error.h>
+
+using namespace llvm;
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMSchedModelInfo>, "LibLLVMSchedModelInfo must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMProcResource>, "LibLLVMProcResource must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMResourceUsage>, "LibLLVMResourceUsage must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMOpcodeSchedInfo>, "LibLLVMOpcodeSchedInfo must be blittable for stable ABI binding");
+
+    // Tables of a scheduling model; The names all refer to the constant tables generated for the target so
+    // the subtarget and instruction info are only needed while building the tables.
+    struct SchedModelTables
+    {
+        LibLLVMSchedModelInfo Info = {};
+        std::vector<LibLLVMProcResource> ProcResources;
+        std::vector<LibLLVMOpcodeSchedInfo> Opcodes;
+        std::vector<LibLLVMResourceUsage> ResourceUsages;
+    };
+
+    std::unique_ptr<SchedModelTables> BuildTables(MCSubtargetInfo const& sti, MCInstrInfo const& mii)
+    {
+        MCSchedModel const& model = sti.getSchedModel();
+        auto tables = std::make_unique<SchedModelTables>();
+        for (unsigned i = 0; i < model.getNumProcResourceKinds(); ++i)
+        {
+            MCProcResourceDesc const& resource = *model.getProcResource(i);
+            StringRef name = resource.Name == nullptr ? StringRef() : StringRef(resource.Name);
+            tables->ProcResources.push_back({ name.data()
+                                            , name.size()
+                                            , resource.NumUnits
+                                            , resource.BufferSize
+                                            , resource.SuperIdx
+                                            , resource.SubUnitsIdxBegin == nullptr ? 0u : resource.NumUnits
+                                            });
+        }
+
+        tables->Opcodes.reserve(mii.getNumOpcodes());
+        for (unsigned opcode = 0; opcode < mii.getNumOpcodes(); ++opcode)
+        {
+            StringRef name = mii.getName(opcode);
+            LibLLVMOpcodeSchedInfo info{ name.data(), name.size(), 0, 0, 0.0, tables->ResourceUsages.size(), 0, false, false };
+
+            MCSchedClassDesc const* schedClass = model.getSchedClassDesc(mii.get(opcode).getSchedClass());
+            if (schedClass != nullptr && schedClass->isValid())
+            {
+                info.IsValid = true;
+                info.IsVariant = schedClass->isVariant();
+                if (!info.IsVariant)
+                {
+                    info.Latency = MCSchedModel::computeInstrLatency(sti, *schedClass);
+                    info.NumMicroOps = schedClass->NumMicroOps;
+                    info.ReciprocalThroughput = MCSchedModel::getReciprocalThroughput(sti, *schedClass);
+                    for (auto it = sti.getWriteProcResBegin(schedClass); it != sti.getWriteProcResEnd(schedClass); ++it)
+                    {
+                        tables->ResourceUsages.push_back({ it->ProcResourceIdx, it->AcquireAtCycle, it->ReleaseAtCycle });
+                    }
+
+                    info.NumResourceUsages = static_cast<uint32_t>(tables->ResourceUsages.size() - info.FirstResourceUsage);
+                }
+            }
+
+            tables->Opcodes.push_back(info);
+        }
+
+        LibLLVMSchedModelInfo& summary = tables->Info;
+        summary.IssueWidth = model.IssueWidth;
+        summary.MicroOpBufferSize = model.MicroOpBufferSize;
+        summary.LoopMicroOpBufferSize = model.LoopMicroOpBufferSize;
+        summary.LoadLatency = model.LoadLatency;
+        summary.HighLatency = model.HighLatency;
+        summary.MispredictPenalty = model.MispredictPenalty;
+        summary.IsOutOfOrder = model.isOutOfOrder();
+        summary.CompleteModel = model.isComplete();
+        summary.NumProcResources = static_cast<uint32_t>(tables->ProcResources.size());
+        summary.NumOpcodes = static_cast<uint32_t>(tables->Opcodes.size());
+        summary.NumResourceUsages = tables->ResourceUsages.size();
+        return tables;
+    }
+
+    Expected<SchedModelTables const*> GetTables(StringRef triple, StringRef cpu)
+    {
+        // Tables are never removed so the results remain valid after the lock is released
+        static std::mutex cacheLock;
+        static StringMap<std::unique_ptr<SchedModelTables>> cache;
+
+        std::string key = (triple + Twine('\0') + cpu).str();
+        std::lock_guard<std::mutex> lock(cacheLock);
+        auto it = cache.find(key);
+        if (it != cache.end())
+        {
+            return it->second.get();
+        }
+
+        std::string errMsg;
+        Target const* target = TargetRegistry::lookupTarget(triple.str(), errMsg);
+        if (target == nullptr)
+        {
+            return createStringError(inconvertibleErrorCode(), errMsg.c_str());
+        }
+
+        std::unique_ptr<MCSubtargetInfo const> sti(target->createMCSubtargetInfo(triple.str(), cpu, StringRef()));
+        if (!sti)
+        {
+            return createStringError(inconvertibleErrorCode(), "Unable to create subtarget info for the target");
+        }
+
+        if (!sti->isCPUStringValid(cpu))
+        {
+            return createStringError(inconvertibleErrorCode(), "cpu is not valid for the target");
+        }
+
+        if (!sti->getSchedModel().hasInstrSchedModel())
+        {
+            return createStringError(inconvertibleErrorCode(), "cpu does not have a scheduling model");
+        }
+
+        std::unique_ptr<MCInstrInfo const> mii(target->createMCInstrInfo());
+        if (!mii)
+        {
+            return createStringError(inconvertibleErrorCode(), "Unable to create instruction info for the target");
+        }
+
+        auto [entry, inserted] = cache.try_emplace(key, BuildTables(*sti, *mii));
+        return entry->second.get();
+    }
+
+    inline SchedModelTables const* unwrap(LibLLVMSchedModelRef model)
+    {
+        return reinterpret_cast<SchedModelTables const*>(model);
+    }
+
+    inline LibLLVMSchedModelRef wrap(SchedModelTables const* model)
+    {
+        return reinterpret_cast<LibLLVMSchedModelRef>(const_cast<SchedModelTables*>(model));
+    }
+}
+
+extern "C"
+{
+    LLVMErrorRef LibLLVMGetSchedModel( char const* triple
+                                     , size_t tripleLen
+                                     , char const* cpu
+                                     , size_t cpuLen
+                                     , LibLLVMSchedModelRef* outRetVal
+                                     )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        if (triple == nullptr || tripleLen == 0)
+        {
+            return LLVMCreateStringError("triple is null or empty");
+        }
+
+        if (cpu == nullptr || cpuLen == 0)
+        {
+            return LLVMCreateStringError("cpu is null or empty");
+        }
+
+        Expected<SchedModelTables const*> tables = GetTables(StringRef(triple, tripleLen), StringRef(cpu, cpuLen));
+        if (!tables)
+        {
+            return wrap(tables.takeError());
+        }
+
+        *outRetVal = wrap(*tables);
+        return nullptr;
+    }
+
+    void LibLLVMSchedModelGetInfo( LibLLVMSchedModelRef model, LibLLVMSchedModelInfo* info )
+    {
+        *info = unwrap(model)->Info;
+    }
+
+    LibLLVMProcResource const* LibLLVMSchedModelGetProcResources( LibLLVMSchedModelRef model, size_t* numResources )
+    {
+        *numResources = unwrap(model)->ProcResources.size();
+        return unwrap(model)->ProcResources.data();
+    }
+
+    LibLLVMOpcodeSchedInfo const* LibLLVMSchedModelGetOpcodes( LibLLVMSchedModelRef model, size_t* numOpcodes )
+    {
+        *numOpcodes = unwrap(model)->Opcodes.size();
+        return unwrap(model)->Opcodes.data();
+    }
+
+    LibLLVMResourceUsage const* LibLLVMSchedModelGetResourceUsages( LibLLVMSchedModelRef model, size_t* numUsages )
+    {
+        *numUsages = unwrap(model)->ResourceUsages.size();
+        return unwrap(model)->ResourceUsages.data();
+    }
+}
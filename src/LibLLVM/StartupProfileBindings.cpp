@@ -0,0 +1,167 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+#include <llvm/Support/CommandLine.h>
+
+#include "libllvm-c/StartupProfileBindings.h"
+#include "libllvm-c/TargetRegistrationBindings.h"
+
+using namespace llvm;
+
+// Startup profiling is enabled with the LibLLVMStartupProfile build property
+// (see: Build-LibLLVMAndPackage.ps1 -StartupProfile) which defines LIBLLVM_STARTUP_PROFILE
+//
+// The time spent in static initialization is measured by placing a marker in the CRT
+// "lib" initializer segment, which runs before ANY of the "user" initializers (all of
+// LLVM's static constructors) and a second one in the last CRT initializer section,
+// which runs after all of them. This is ONLY supported for MSVC builds.
+#if defined(LIBLLVM_STARTUP_PROFILE) && LIBLLVM_STARTUP_PROFILE && defined(_MSC_VER)
+#define LIBLLVM_HAS_STARTUP_PROFILE 1
+#else
+#define LIBLLVM_HAS_STARTUP_PROFILE 0
+#endif
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMStartupProfile>, "LibLLVMStartupProfile must be blittable for stable ABI binding");
+
+#if LIBLLVM_HAS_STARTUP_PROFILE
+    using StartupClock = std::chrono::steady_clock;
+
+    std::uint64_t ElapsedNs(StartupClock::time_point start, StartupClock::time_point end)
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    struct StartupTimes
+    {
+        StartupClock::time_point InitStart;
+        StartupClock::time_point InitEnd;
+        std::uint64_t ProcessStartToLoadNs = 0;
+    };
+
+    // Constant initialized so that it is valid before any initializer runs
+    StartupTimes Times;
+
+    std::uint64_t GetProcessStartToNowNs()
+    {
+        FILETIME creation;
+        FILETIME exitTime;
+        FILETIME kernel;
+        FILETIME user;
+        if (!::GetProcessTimes(::GetCurrentProcess(), &creation, &exitTime, &kernel, &user))
+        {
+            return 0;
+        }
+
+        FILETIME now;
+        ::GetSystemTimePreciseAsFileTime(&now);
+
+        ULARGE_INTEGER creationTicks{ { creation.dwLowDateTime, creation.dwHighDateTime } };
+        ULARGE_INTEGER nowTicks{ { now.dwLowDateTime, now.dwHighDateTime } };
+
+        // FILETIME is in 100ns units
+        return nowTicks.QuadPart > creationTicks.QuadPart ? (nowTicks.QuadPart - creationTicks.QuadPart) * 100 : 0;
+    }
+
+    struct StaticInitStartMarker
+    {
+        StaticInitStartMarker()
+        {
+            Times.InitStart = StartupClock::now();
+            Times.ProcessStartToLoadNs = GetProcessStartToNowNs();
+        }
+    };
+
+    void __cdecl OnStaticInitEnd()
+    {
+        Times.InitEnd = StartupClock::now();
+    }
+#endif
+}
+
+#if LIBLLVM_HAS_STARTUP_PROFILE
+#pragma warning(push)
+#pragma warning(disable: 4073) // initializers put in library initialization area
+#pragma init_seg(lib)
+namespace
+{
+    StaticInitStartMarker StartMarker;
+}
+#pragma warning(pop)
+
+// ".CRT$XCY" sorts after the ".CRT$XCU" section used for all "user" initializers
+#pragma section(".CRT$XCY", long, read)
+extern "C" __declspec(allocate(".CRT$XCY")) void (__cdecl* const LibLLVMStaticInitEndMarker)() = OnStaticInitEnd;
+#endif
+
+extern "C"
+{
+    LLVMBool LibLLVMIsStartupProfileEnabled()
+    {
+        return LIBLLVM_HAS_STARTUP_PROFILE;
+    }
+
+    LLVMErrorRef LibLLVMGetStartupProfile( LibLLVMStartupProfile* pProfile )
+    {
+        if (pProfile == nullptr)
+        {
+            return LLVMCreateStringError("Invalid profile pointer");
+        }
+
+        *pProfile = LibLLVMStartupProfile{};
+
+#if LIBLLVM_HAS_STARTUP_PROFILE
+        // Referencing the end marker ensures the linker does not discard it as unused
+        if (LibLLVMStaticInitEndMarker != nullptr && Times.InitEnd >= Times.InitStart)
+        {
+            static StartupClock::time_point const FirstQuery = StartupClock::now();
+            pProfile->ProcessStartToLoadNs = Times.ProcessStartToLoadNs;
+            pProfile->StaticInitNs = ElapsedNs(Times.InitStart, Times.InitEnd);
+            pProfile->LoadToFirstQueryNs = ElapsedNs(Times.InitEnd, FirstQuery);
+        }
+#endif
+
+        pProfile->RegisteredOptionCount = static_cast<uint32_t>(cl::getRegisteredOptions().size());
+
+        std::vector<LibLLVMTargetRegistrationInfo> infos(LibLLVMGetNumTargetRegistrationInfos());
+        LLVMErrorRef err = LibLLVMGetTargetRegistrationInfos(infos.data(), static_cast<int32_t>(infos.size()));
+        if (err != nullptr)
+        {
+            return err;
+        }
+
+        for (auto const& info : infos)
+        {
+            std::array<std::uint64_t, 6> const times{
+                info.TargetNs,
+                info.TargetInfoNs,
+                info.TargetMachineNs,
+                info.AsmPrinterNs,
+                info.DisassemblerNs,
+                info.AsmParserNs
+            };
+
+            for (std::uint64_t t : times)
+            {
+                pProfile->TargetRegistrationNs += t;
+            }
+
+            // Count each registered kind (bit) of the target
+            for (std::int32_t bits = info.Registered; bits != 0; bits &= bits - 1)
+            {
+                ++pProfile->TargetRegistrationCount;
+            }
+        }
+
+        return nullptr;
+    }
+}
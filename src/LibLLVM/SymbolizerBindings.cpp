@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "libllvm-c/SymbolizerBindings.h"
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/DebugInfo/DIContext.h>
+#include <llvm/DebugInfo/Symbolize/Symbolize.h>
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/Parallel.h>
+#include <llvm/Support/StringSaver.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/xxhash.h>
+
+using namespace llvm;
+using namespace llvm::symbolize;
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMSymbolizeRequest>, "LibLLVMSymbolizeRequest must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMSymbolizedFrame>, "LibLLVMSymbolizedFrame must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMSymbolizedAddress>, "LibLLVMSymbolizedAddress must be blittable for stable ABI binding");
+
+    // An LLVMSymbolizer is NOT thread safe, so each shard has its own symbolizer (and cache) that is
+    // only used while holding the lock for the shard.
+    struct SymbolizerShard
+    {
+        SymbolizerShard(LLVMSymbolizer::Options const& options)
+            : Impl(options)
+        {
+        }
+
+        std::mutex Lock;
+        LLVMSymbolizer Impl;
+    };
+
+    class Symbolizer
+    {
+    public:
+        Symbolizer(bool demangle, uint32_t numShards, uint64_t maxCacheBytes)
+        {
+            LLVMSymbolizer::Options options;
+            options.Demangle = demangle;
+            if (maxCacheBytes != 0)
+            {
+                options.MaxCacheSize = static_cast<size_t>(maxCacheBytes);
+            }
+
+            if (numShards == 0)
+            {
+                numShards = hardware_concurrency().compute_thread_count();
+            }
+
+            for (uint32_t i = 0; i < numShards; ++i)
+            {
+                Shards.push_back(std::make_unique<SymbolizerShard>(options));
+            }
+        }
+
+        // Gets the shard that resolves the first chunk of the requests for a binary in a batch
+        size_t GetHomeShardIndex(StringRef modulePath) const
+        {
+            return static_cast<size_t>(xxh3_64bits(modulePath) % Shards.size());
+        }
+
+        SymbolizerShard& GetShard(size_t index)
+        {
+            return *Shards[index];
+        }
+
+        size_t GetNumShards() const
+        {
+            return Shards.size();
+        }
+
+    private:
+        std::vector<std::unique_ptr<SymbolizerShard>> Shards;
+    };
+
+    // Minimum number of requests for a binary in a batch for each additional shard that resolves them. Every
+    // shard that resolves requests of a binary parses and caches its debug information, so a binary is only
+    // spread across shards when it has enough requests to amortize that.
+    constexpr size_t MinRequestsPerShard = 256;
+
+    // Results own all of the strings for the frames; names and files repeat heavily across a large
+    // batch so the strings are uniqued.
+    struct SymbolizeResults
+    {
+        SymbolizeResults()
+            : Strings(Allocator)
+        {
+        }
+
+        StringRef Save(std::string const& str)
+        {
+            // LLVM uses a constant string for values that are not known
+            if (str.empty() || str == DILineInfo::BadString)
+            {
+                return StringRef();
+            }
+
+            return Strings.save(str);
+        }
+
+        BumpPtrAllocator Allocator;
+        UniqueStringSaver Strings;
+        std::vector<LibLLVMSymbolizedAddress> Addresses;
+        std::vector<LibLLVMSymbolizedFrame> Frames;
+    };
+
+    // Result of a single request as resolved by a shard, before it is stored in the results
+    struct ResolvedAddress
+    {
+        DIInliningInfo Info;
+        std::string Error;
+    };
+
+    void Resolve(LLVMSymbolizer& symbolizer, LibLLVMSymbolizeRequest const& request, ResolvedAddress& result)
+    {
+        object::SectionedAddress address{ request.Address, object::SectionedAddress::UndefSection };
+        Expected<DIInliningInfo> info = symbolizer.symbolizeInlinedCode(std::string(request.ModulePath, request.ModulePathLen), address);
+        if (!info)
+        {
+            result.Error = toString(info.takeError());
+            return;
+        }
+
+        result.Info = std::move(*info);
+    }
+
+    inline Symbolizer* unwrap(LibLLVMSymbolizerRef symbolizer)
+    {
+        return reinterpret_cast<Symbolizer*>(symbolizer);
+    }
+
+    inline LibLLVMSymbolizerRef wrap(Symbolizer* symbolizer)
+    {
+        return reinterpret_cast<LibLLVMSymbolizerRef>(symbolizer);
+    }
+
+    inline SymbolizeResults* unwrap(LibLLVMSymbolizeResultsRef results)
+    {
+        return reinterpret_cast<SymbolizeResults*>(results);
+    }
+
+    inline LibLLVMSymbolizeResultsRef wrap(SymbolizeResults* results)
+    {
+        return reinterpret_cast<LibLLVMSymbolizeResultsRef>(results);
+    }
+}
+
+extern "C"
+{
+    LibLLVMSymbolizerRef LibLLVMCreateSymbolizer( LLVMBool demangle, uint32_t numShards, uint64_t maxCacheBytes )
+    {
+        return wrap(new Symbolizer(demangle, numShards, maxCacheBytes));
+    }
+
+    void LibLLVMDisposeSymbolizer( LibLLVMSymbolizerRef symbolizer )
+    {
+        delete unwrap(symbolizer);
+    }
+
+    void LibLLVMSymbolizerClearCache( LibLLVMSymbolizerRef symbolizer )
+    {
+        Symbolizer& self = *unwrap(symbolizer);
+        for (size_t i = 0; i < self.GetNumShards(); ++i)
+        {
+            SymbolizerShard& shard = self.GetShard(i);
+            std::lock_guard<std::mutex> lock(shard.Lock);
+            shard.Impl.flush();
+        }
+    }
+
+    LLVMErrorRef LibLLVMSymbolizeBatch( LibLLVMSymbolizerRef symbolizer
+                                      , LibLLVMSymbolizeRequest const* requests
+                                      , size_t numRequests
+                                      , LibLLVMSymbolizeResultsRef* outResults
+                                      )
+    {
+        if (outResults == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outResults' is null!");
+        }
+
+        *outResults = nullptr;
+        if (requests == nullptr && numRequests > 0)
+        {
+            return LLVMCreateStringError("requests is null");
+        }
+
+        Symbolizer& self = *unwrap(symbolizer);
+
+        StringMap<std::vector<size_t>> requestsByModule;
+        for (size_t i = 0; i < numRequests; ++i)
+        {
+            if (requests[i].ModulePath == nullptr || requests[i].ModulePathLen == 0)
+            {
+                return LLVMCreateStringError("Request has a null or empty module path");
+            }
+
+            requestsByModule[StringRef(requests[i].ModulePath, requests[i].ModulePathLen)].push_back(i);
+        }
+
+        // The requests of a binary are sorted by address and split into contiguous chunks, one for each of
+        // consecutive shards starting at the home shard of the binary; A binary with few requests stays on
+        // its home shard so its debug information is only loaded once.
+        std::vector<std::vector<size_t>> requestsByShard(self.GetNumShards());
+        for (auto const& entry : requestsByModule)
+        {
+            std::vector<size_t> moduleRequests = entry.getValue();
+            llvm::sort(moduleRequests, [&](size_t lhs, size_t rhs) { return requests[lhs].Address < requests[rhs].Address; });
+
+            size_t numChunks = std::clamp<size_t>(moduleRequests.size() / MinRequestsPerShard, 1, self.GetNumShards());
+            size_t homeShard = self.GetHomeShardIndex(entry.getKey());
+            for (size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                size_t begin = moduleRequests.size() * chunk / numChunks;
+                size_t end = moduleRequests.size() * (chunk + 1) / numChunks;
+                std::vector<size_t>& shardRequests = requestsByShard[(homeShard + chunk) % self.GetNumShards()];
+                shardRequests.insert(shardRequests.end(), moduleRequests.begin() + begin, moduleRequests.begin() + end);
+            }
+        }
+
+        // Each request is resolved by exactly one shard so no synchronization of the results is needed
+        std::vector<ResolvedAddress> resolved(numRequests);
+        parallelFor(0, requestsByShard.size(), [&](size_t shardIndex)
+            {
+                if (requestsByShard[shardIndex].empty())
+                {
+                    return;
+                }
+
+                SymbolizerShard& shard = self.GetShard(shardIndex);
+                std::lock_guard<std::mutex> lock(shard.Lock);
+                for (size_t requestIndex : requestsByShard[shardIndex])
+                {
+                    Resolve(shard.Impl, requests[requestIndex], resolved[requestIndex]);
+                }
+
+                shard.Impl.pruneCache();
+            });
+
+        auto results = std::make_unique<SymbolizeResults>();
+        results->Addresses.resize(numRequests);
+        for (size_t i = 0; i < numRequests; ++i)
+        {
+            LibLLVMSymbolizedAddress& address = results->Addresses[i];
+            address.FirstFrame = results->Frames.size();
+            address.NumFrames = resolved[i].Info.getNumberOfFrames();
+            address.Error = nullptr;
+            address.ErrorLen = 0;
+            if (!resolved[i].Error.empty())
+            {
+                StringRef error = results->Strings.save(resolved[i].Error);
+                address.Error = error.data();
+                address.ErrorLen = error.size();
+            }
+
+            for (uint32_t frameIndex = 0; frameIndex < address.NumFrames; ++frameIndex)
+            {
+                DILineInfo const& lineInfo = resolved[i].Info.getFrame(frameIndex);
+                StringRef functionName = results->Save(lineInfo.FunctionName);
+                StringRef fileName = results->Save(lineInfo.FileName);
+                results->Frames.push_back({ functionName.data()
+                                          , functionName.size()
+                                          , fileName.data()
+                                          , fileName.size()
+                                          , lineInfo.Line
+                                          , lineInfo.Column
+                                          , lineInfo.StartLine
+                                          , lineInfo.Discriminator
+                                          });
+            }
+        }
+
+        *outResults = wrap(results.release());
+        return nullptr;
+    }
+
+    void LibLLVMDisposeSymbolizeResults( LibLLVMSymbolizeResultsRef results )
+    {
+        delete unwrap(results);
+    }
+
+    LibLLVMSymbolizedAddress const* LibLLVMSymbolizeResultsGetAddresses( LibLLVMSymbolizeResultsRef results, size_t* numAddresses )
+    {
+        *numAddresses = unwrap(results)->Addresses.size();
+        return unwrap(results)->Addresses.data();
+    }
+
+    LibLLVMSymbolizedFrame const* LibLLVMSymbolizeResultsGetFrames( LibLLVMSymbolizeResultsRef results, size_t* numFrames )
+    {
+        *numFrames = unwrap(results)->Frames.size();
+        return unwrap(results)->Frames.data();
+    }
+}
@@ -1,5 +1,12 @@
 #include <string_view>
 #include <limits>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/TargetParser/Triple.h>
 
 #include <llvm/Support/Error.h>
 #include <llvm/Config/llvm-config.h>
@@ -1055,39 +1062,6 @@ namespace
 #endif
     }
 
-    void RegisterAllTargets(LibLLVMTargetRegistrationKind registrations = TargetRegistration_All)
-    {
-        if ( has_flag(registrations, TargetRegistration_Target))
-        {
-            LLVMInitializeAllTargets();
-        }
-
-        if (has_flag(registrations, TargetRegistration_TargetInfo))
-        {
-            LLVMInitializeAllTargetInfos();
-        }
-
-        if (has_flag(registrations, TargetRegistration_TargetMachine))
-        {
-            LLVMInitializeAllTargetMCs();
-        }
-
-        if (has_flag(registrations, TargetRegistration_AsmPrinter))
-        {
-            LLVMInitializeAllAsmPrinters();
-        }
-
-        if (has_flag(registrations, TargetRegistration_Disassembler))
-        {
-            LLVMInitializeAllDisassemblers();
-        }
-
-        if( has_flag(registrations, TargetRegistration_AsmParser ) )
-        {
-            LLVMInitializeAllAsmParsers( );
-        }
-    }
-
     LLVMErrorRef validate_supported_target(LibLLVMCodeGenTarget target)
     {
         // If the target is not a known one then report that immediately
@@ -1111,21 +1085,14 @@ namespace
         // Success for LLVMErrorRef is nullptr
         return err != nullptr;
     }
-}
 
-extern "C"
-{
-    LLVMErrorRef LibLLVMRegisterTarget(LibLLVMCodeGenTarget target, LibLLVMTargetRegistrationKind registrations)
+    // Dispatches registration of a supported target; LibLLVMRegisterTarget() splits CodeGenTarget_All into each
+    // available target so they are tracked independently, the case here only covers direct calls.
+    void RegisterTargetKinds(LibLLVMCodeGenTarget target, LibLLVMTargetRegistrationKind registrations)
     {
-        LLVMErrorRef validationResult = validate_supported_target(target);
-        if (Failed(validationResult))
-        {
-            return validationResult;
-        }
-
         // NOTE: Some of these may result in a NOP and won't actually be used.
         //       Since the target is passed by caller it isn't a compile time constant.
-        //       It is checked above for a supported value so this will never call into
+        //       It is checked by the caller for a supported value so this will never call into
         //       the NOP stubs. This saves on LOTs of preprocessor conditionals. A good
         //       optimizer can see that any of these are NOP and simplify this to ONLY
         //       the supported targets.
@@ -1133,97 +1100,411 @@ extern "C"
         {
         case CodeGenTarget_Native:
             RegisterTargetNative(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_AArch64:
             RegisterTargetAArch64(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_AMDGPU:
             RegisterTargetAMDGPU(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_ARM:
             RegisterTargetARM(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_AVR:
             RegisterTargetAVR(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_BPF:
             RegisterTargetBPF(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_Hexagon:
             RegisterTargetHexagon(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_Lanai:
             RegisterTargetLanai(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_LoongArch:
             RegisterTargetLoongArch(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_MIPS:
             RegisterTargetMIPS(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_MSP430:
             RegisterTargetMSP430(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_NVPTX:
             RegisterTargetNvidiaPTX(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_PowerPC:
             RegisterTargetPowerPC(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_RISCV:
             RegisterTargetRISCV(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_Sparc:
             RegisterTargetSparc(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_SPIRV:
             RegisterTargetSPIRV(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_SystemZ:
             RegisterTargetSystemZ(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_VE:
             RegisterTargetVE(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_WebAssembly:
             RegisterTargetWebAssembly(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_X86:
             RegisterTargetX86(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_XCore:
             RegisterTargetXCore(registrations);
-            return nullptr;
+            break;
 
         case CodeGenTarget_All:
-            RegisterAllTargets(registrations);
-            return nullptr;
+            for (LibLLVMCodeGenTarget availableTarget : AvailableTargets)
+            {
+                RegisterTargetKinds(availableTarget, registrations);
+            }
+            break;
+
+        default:
+            // Unknown values are rejected by validate_supported_target() before this is called
+            break;
+        }
+    }
+
+
+#define LIBLLVM_STRINGIZE_(x) #x
+#define LIBLLVM_STRINGIZE(x) LIBLLVM_STRINGIZE_(x)
+
+    // Concrete target for the native architecture of this build.
+    constexpr LibLLVMCodeGenTarget NativeTarget = mk_target(LIBLLVM_STRINGIZE(LLVM_NATIVE_ARCH));
+
+#undef LIBLLVM_STRINGIZE
+#undef LIBLLVM_STRINGIZE_
+
+#if INCLUDE_COMPILE_TIME_UT
+    static_assert(NativeTarget != CodeGenTarget_None, "Native architecture is not mapped to a known target");
+#endif
+
+    // Registration kinds in the order of the timing fields of LibLLVMTargetRegistrationInfo
+    constexpr std::array RegistrationKinds {
+        TargetRegistration_Target,
+        TargetRegistration_TargetInfo,
+        TargetRegistration_TargetMachine,
+        TargetRegistration_AsmPrinter,
+        TargetRegistration_Disassembler,
+        TargetRegistration_AsmParser,
+    };
+
+    // Kinds that are removed from a reduced footprint build (see: ExcludedComponentStubs.cpp)
+    constexpr std::int32_t ExcludedRegistrations = TargetRegistration_None
+#if LIBLLVM_EXCLUDE_ASMPARSER
+        | TargetRegistration_AsmParser
+#endif
+#if LIBLLVM_EXCLUDE_DISASSEMBLER
+        | TargetRegistration_Disassembler
+#endif
+        ;
+
+    // Kinds that are deferred until first use when lazy registration is enabled. Only the kinds that are used
+    // through entry points of this library, which complete the pending registration before the target lookup,
+    // are deferred. The AsmPrinter is used by the LLVM-C code generation (i.e. LLVMTargetMachineEmitToFile())
+    // that this library cannot intercept, so it is always registered immediately.
+    constexpr std::int32_t LazyRegistrations = TargetRegistration_Disassembler | TargetRegistration_AsmParser;
+
+    // Registration state has one slot for the native target followed by one for each available target
+    constexpr size_t NumRegistrationSlots = AvailableTargets.size() + 1;
+
+    constexpr size_t SlotOf(LibLLVMCodeGenTarget target)
+    {
+        if (target == CodeGenTarget_Native)
+        {
+            return 0;
+        }
+
+        return 1 + (std::find(std::begin(AvailableTargets), std::end(AvailableTargets), target) - std::begin(AvailableTargets));
+    }
+
+    constexpr LibLLVMCodeGenTarget TargetOfSlot(size_t slot)
+    {
+        return slot == 0 ? CodeGenTarget_Native : AvailableTargets[slot - 1];
+    }
+
+    LibLLVMCodeGenTarget TargetFromArch(Triple::ArchType arch)
+    {
+        switch (arch)
+        {
+        case Triple::aarch64:
+        case Triple::aarch64_be:
+        case Triple::aarch64_32:
+            return CodeGenTarget_AArch64;
+
+        case Triple::amdgcn:
+        case Triple::r600:
+            return CodeGenTarget_AMDGPU;
+
+        case Triple::arm:
+        case Triple::armeb:
+        case Triple::thumb:
+        case Triple::thumbeb:
+            return CodeGenTarget_ARM;
+
+        case Triple::avr:
+            return CodeGenTarget_AVR;
+
+        case Triple::bpfel:
+        case Triple::bpfeb:
+            return CodeGenTarget_BPF;
+
+        case Triple::hexagon:
+            return CodeGenTarget_Hexagon;
+
+        case Triple::lanai:
+            return CodeGenTarget_Lanai;
+
+        case Triple::loongarch32:
+        case Triple::loongarch64:
+            return CodeGenTarget_LoongArch;
+
+        case Triple::mips:
+        case Triple::mipsel:
+        case Triple::mips64:
+        case Triple::mips64el:
+            return CodeGenTarget_MIPS;
+
+        case Triple::msp430:
+            return CodeGenTarget_MSP430;
+
+        case Triple::nvptx:
+        case Triple::nvptx64:
+            return CodeGenTarget_NVPTX;
+
+        case Triple::ppc:
+        case Triple::ppcle:
+        case Triple::ppc64:
+        case Triple::ppc64le:
+            return CodeGenTarget_PowerPC;
+
+        case Triple::riscv32:
+        case Triple::riscv64:
+            return CodeGenTarget_RISCV;
+
+        case Triple::sparc:
+        case Triple::sparcv9:
+        case Triple::sparcel:
+            return CodeGenTarget_Sparc;
+
+        case Triple::spirv:
+        case Triple::spirv32:
+        case Triple::spirv64:
+            return CodeGenTarget_SPIRV;
+
+        case Triple::systemz:
+            return CodeGenTarget_SystemZ;
+
+        case Triple::ve:
+            return CodeGenTarget_VE;
+
+        case Triple::wasm32:
+        case Triple::wasm64:
+            return CodeGenTarget_WebAssembly;
+
+        case Triple::x86:
+        case Triple::x86_64:
+            return CodeGenTarget_X86;
+
+        case Triple::xcore:
+            return CodeGenTarget_XCore;
 
         default:
-            return LLVMCreateStringError("Unknown target type");
+            return CodeGenTarget_None;
         }
     }
 
+    struct TargetRegistrationState
+    {
+        // Written only while holding the lock, AFTER the registration completes. Thus, it is safe
+        // to read without the lock to skip registrations that are already done.
+        std::atomic<std::int32_t> Registered{ 0 };
+        std::int32_t Pending = 0;
+        std::array<std::uint64_t, RegistrationKinds.size()> Nanoseconds{};
+    };
+
+    // Process wide registration state that ensures each piece of each target is registered
+    // exactly once no matter how many times, or from how many threads, it is requested.
+    class TargetRegistrationTable
+    {
+    public:
+        // target must be a supported target and NOT CodeGenTarget_All
+        void Register(LibLLVMCodeGenTarget target, std::int32_t registrations, std::int32_t deferred)
+        {
+            TargetRegistrationState& state = Slots[SlotOf(target)];
+            std::int32_t registered = state.Registered.load(std::memory_order_acquire);
+            registrations &= TargetRegistration_All & ~registered;
+            deferred &= TargetRegistration_All & ~registered;
+            if (registrations == 0 && deferred == 0)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(Lock);
+            registrations &= ~state.Registered.load(std::memory_order_relaxed);
+            state.Pending |= deferred & ~registrations;
+
+            // For native registration all three are done at once, so the time is recorded against the target
+            if (target == CodeGenTarget_Native && (registrations & TargetRegistration_CodeGenRegistration) != 0)
+            {
+                state.Nanoseconds[0] = TimedRegistration(target, TargetRegistration_CodeGenRegistration);
+                MarkRegistered(target, TargetRegistration_CodeGenRegistration);
+                registrations &= ~TargetRegistration_CodeGenRegistration;
+            }
+
+            for (size_t i = 0; i < RegistrationKinds.size(); ++i)
+            {
+                if (has_flag(static_cast<LibLLVMTargetRegistrationKind>(registrations), RegistrationKinds[i]))
+                {
+                    state.Nanoseconds[i] = TimedRegistration(target, RegistrationKinds[i]);
+                    MarkRegistered(target, RegistrationKinds[i]);
+                }
+            }
+        }
+
+        // Registers any of the requested kinds that were previously deferred for target
+        void RegisterPending(LibLLVMCodeGenTarget target, std::int32_t registrations)
+        {
+            std::int32_t pending = 0;
+            {
+                std::lock_guard<std::mutex> lock(Lock);
+                pending = Slots[SlotOf(target)].Pending & registrations;
+            }
+
+            if (pending != 0)
+            {
+                Register(target, pending, 0);
+            }
+        }
+
+        void GetInfo(size_t slot, LibLLVMTargetRegistrationInfo& info)
+        {
+            std::lock_guard<std::mutex> lock(Lock);
+            TargetRegistrationState const& state = Slots[slot];
+            info.Target = TargetOfSlot(slot);
+            info.Registered = static_cast<LibLLVMTargetRegistrationKind>(state.Registered.load(std::memory_order_relaxed));
+            info.Pending = static_cast<LibLLVMTargetRegistrationKind>(state.Pending);
+            info.TargetNs = state.Nanoseconds[0];
+            info.TargetInfoNs = state.Nanoseconds[1];
+            info.TargetMachineNs = state.Nanoseconds[2];
+            info.AsmPrinterNs = state.Nanoseconds[3];
+            info.DisassemblerNs = state.Nanoseconds[4];
+            info.AsmParserNs = state.Nanoseconds[5];
+        }
+
+        static TargetRegistrationTable& Instance()
+        {
+            static TargetRegistrationTable table;
+            return table;
+        }
+
+        static std::atomic<bool> LazyMode;
+
+    private:
+        static std::uint64_t TimedRegistration(LibLLVMCodeGenTarget target, LibLLVMTargetRegistrationKind registrations)
+        {
+            auto start = std::chrono::steady_clock::now();
+            RegisterTargetKinds(target, registrations);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+
+        static void MarkRegistered(TargetRegistrationState& state, std::int32_t registrations)
+        {
+            state.Pending &= ~registrations;
+            state.Registered.fetch_or(registrations, std::memory_order_release);
+        }
+
+        // Native is an alias of the target of the native architecture; each kind of either one runs the same
+        // initialization so registering a kind of one also registers it for the other.
+        void MarkRegistered(LibLLVMCodeGenTarget target, std::int32_t registrations)
+        {
+            MarkRegistered(Slots[SlotOf(target)], registrations);
+            if (!contains(AvailableTargets, NativeTarget))
+            {
+                return;
+            }
+
+            if (target == CodeGenTarget_Native)
+            {
+                MarkRegistered(Slots[SlotOf(NativeTarget)], registrations);
+            }
+            else if (target == NativeTarget)
+            {
+                MarkRegistered(Slots[SlotOf(CodeGenTarget_Native)], registrations);
+            }
+        }
+
+        std::mutex Lock;
+        std::array<TargetRegistrationState, NumRegistrationSlots> Slots;
+    };
+
+    std::atomic<bool> TargetRegistrationTable::LazyMode{ false };
+}
+
+extern "C"
+{
+    LLVMErrorRef LibLLVMRegisterTarget(LibLLVMCodeGenTarget target, LibLLVMTargetRegistrationKind registrations)
+    {
+        LLVMErrorRef validationResult = validate_supported_target(target);
+        if (Failed(validationResult))
+        {
+            return validationResult;
+        }
+
+        std::int32_t available = registrations & ~ExcludedRegistrations;
+        std::int32_t deferred = TargetRegistrationTable::LazyMode.load(std::memory_order_relaxed)
+                              ? (available & LazyRegistrations)
+                              : 0;
+
+        std::int32_t immediate = available & ~deferred;
+
+        // All is registered one target at a time so that each is tracked (and timed) independently
+        if (target == CodeGenTarget_All)
+        {
+            for (LibLLVMCodeGenTarget availableTarget : AvailableTargets)
+            {
+                TargetRegistrationTable::Instance().Register(availableTarget, immediate, deferred);
+            }
+        }
+        else
+        {
+            TargetRegistrationTable::Instance().Register(target, immediate, deferred);
+        }
+
+        return nullptr;
+    }
+
     std::int32_t LibLLVMGetNumTargets()
     {
         return AvailableTargets.size();
@@ -1244,6 +1525,64 @@ extern "C"
         return nullptr;
     }
 
+    LibLLVMTargetRegistrationKind LibLLVMGetAvailableTargetRegistrations()
+    {
+        return static_cast<LibLLVMTargetRegistrationKind>(TargetRegistration_All & ~ExcludedRegistrations);
+    }
+
+    void LibLLVMSetLazyTargetRegistration(LLVMBool enable)
+    {
+        TargetRegistrationTable::LazyMode.store(enable != 0, std::memory_order_relaxed);
+    }
+
+    LLVMBool LibLLVMGetLazyTargetRegistration()
+    {
+        return TargetRegistrationTable::LazyMode.load(std::memory_order_relaxed) ? 1 : 0;
+    }
+
+    LLVMErrorRef LibLLVMRegisterPendingTargetForTriple(char const* triple, size_t tripleLen, LibLLVMTargetRegistrationKind registrations)
+    {
+        LibLLVMCodeGenTarget target = TargetFromArch(Triple(StringRef(triple, tripleLen)).getArch());
+        if (target == CodeGenTarget_None)
+        {
+            return LLVMCreateStringError("Unknown target architecture for triple");
+        }
+
+        LLVMErrorRef validationResult = validate_supported_target(target);
+        if (Failed(validationResult))
+        {
+            return validationResult;
+        }
+
+        TargetRegistrationTable::Instance().RegisterPending(target, registrations);
+        if (target == NativeTarget)
+        {
+            TargetRegistrationTable::Instance().RegisterPending(CodeGenTarget_Native, registrations);
+        }
+
+        return nullptr;
+    }
+
+    std::int32_t LibLLVMGetNumTargetRegistrationInfos()
+    {
+        return static_cast<std::int32_t>(NumRegistrationSlots);
+    }
+
+    LLVMErrorRef LibLLVMGetTargetRegistrationInfos(LibLLVMTargetRegistrationInfo* infoArray, std::int32_t lengthOfArray)
+    {
+        if (lengthOfArray < 0 || static_cast<size_t>(lengthOfArray) < NumRegistrationSlots)
+        {
+            return LLVMCreateStringError("Invalid array length provided");
+        }
+
+        for (size_t i = 0; i < NumRegistrationSlots; ++i)
+        {
+            TargetRegistrationTable::Instance().GetInfo(i, infoArray[i]);
+        }
+
+        return nullptr;
+    }
+
     char const* LibLLVMGetVersion(size_t* len)
     {
         *len = LibLLVM::FullBuildNumber.size();
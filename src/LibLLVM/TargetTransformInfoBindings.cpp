@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+#include "libllvm-c/TargetTransformInfoBindings.h"
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Type.h>
+#include <llvm/IR/Value.h>
+#include <llvm/Support/Alignment.h>
+#include <llvm/Support/InstructionCost.h>
+#include <llvm/Support/TypeSize.h>
+#include <llvm/Target/TargetMachine.h>
+
+using namespace llvm;
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMTargetTransformProperties>, "LibLLVMTargetTransformProperties must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMCostQuery>, "LibLLVMCostQuery must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMCostResult>, "LibLLVMCostResult must be blittable for stable ABI binding");
+
+    static_assert(static_cast<int>(LibLLVMTargetCostKind_RecipThroughput) == static_cast<int>(TargetTransformInfo::TCK_RecipThroughput), "LibLLVMTargetCostKind does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMTargetCostKind_Latency) == static_cast<int>(TargetTransformInfo::TCK_Latency), "LibLLVMTargetCostKind does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMTargetCostKind_CodeSize) == static_cast<int>(TargetTransformInfo::TCK_CodeSize), "LibLLVMTargetCostKind does not match LLVM");
+    static_assert(static_cast<int>(LibLLVMTargetCostKind_SizeAndLatency) == static_cast<int>(TargetTransformInfo::TCK_SizeAndLatency), "LibLLVMTargetCostKind does not match LLVM");
+
+    struct TargetTransformInfoHolder
+    {
+        TargetTransformInfoHolder(TargetMachine& tm, Function const& fn)
+            : TTI(tm.getTargetTransformInfo(fn))
+            , Fn(fn)
+        {
+        }
+
+        TargetTransformInfo TTI;
+        Function const& Fn;
+    };
+
+    // Same mapping as the LLVM-C implementation (see: map_from_llvmopcode() in llvm/lib/IR/Core.cpp); returns 0
+    // for values that are not an LLVMOpcode.
+    unsigned GetInstructionOpcode(LLVMOpcode code)
+    {
+        switch (code)
+        {
+#define HANDLE_INST(num, opc, clas) case LLVM##opc: return Instruction::opc;
+#include "llvm/IR/Instruction.def"
+#undef HANDLE_INST
+        }
+
+        return 0;
+    }
+
+    Expected<InstructionCost> GetCost( TargetTransformInfoHolder const& holder
+                                     , TargetTransformInfo::TargetCostKind costKind
+                                     , LibLLVMCostQuery const& query
+                                     )
+    {
+        Type* type = unwrap(query.Type);
+        if (type == nullptr)
+        {
+            return createStringError(inconvertibleErrorCode(), "Type is null");
+        }
+
+        unsigned opcode = GetInstructionOpcode(query.Opcode);
+        switch (query.Kind)
+        {
+        case LibLLVMCostQueryKind_Arithmetic:
+            if (!Instruction::isBinaryOp(opcode) && !Instruction::isUnaryOp(opcode))
+            {
+                return createStringError(inconvertibleErrorCode(), "Opcode is not an arithmetic operator");
+            }
+
+            return holder.TTI.getArithmeticInstrCost(opcode, type, costKind);
+
+        case LibLLVMCostQueryKind_Memory:
+            {
+                if (opcode != Instruction::Load && opcode != Instruction::Store)
+                {
+                    return createStringError(inconvertibleErrorCode(), "Opcode is not a load or store");
+                }
+
+                if (query.Alignment != 0 && !isPowerOf2_32(query.Alignment))
+                {
+                    return createStringError(inconvertibleErrorCode(), "Alignment is not a power of two");
+                }
+
+                Align alignment = query.Alignment == 0
+                                ? holder.Fn.getParent()->getDataLayout().getABITypeAlign(type)
+                                : Align(query.Alignment);
+
+                return holder.TTI.getMemoryOpCost(opcode, type, alignment, query.AddressSpace, costKind);
+            }
+
+        case LibLLVMCostQueryKind_Cast:
+            if (!Instruction::isCast(opcode))
+            {
+                return createStringError(inconvertibleErrorCode(), "Opcode is not a cast");
+            }
+
+            if (query.SrcType == nullptr)
+            {
+                return createStringError(inconvertibleErrorCode(), "SrcType is null");
+            }
+
+            return holder.TTI.getCastInstrCost(opcode, type, unwrap(query.SrcType), TargetTransformInfo::CastContextHint::None, costKind);
+
+        default:
+            return createStringError(inconvertibleErrorCode(), "Invalid cost query kind");
+        }
+    }
+
+    inline TargetTransformInfoHolder* unwrap(LibLLVMTargetTransformInfoRef tti)
+    {
+        return reinterpret_cast<TargetTransformInfoHolder*>(tti);
+    }
+
+    inline LibLLVMTargetTransformInfoRef wrap(TargetTransformInfoHolder* tti)
+    {
+        return reinterpret_cast<LibLLVMTargetTransformInfoRef>(tti);
+    }
+}
+
+extern "C"
+{
+    LLVMErrorRef LibLLVMCreateTargetTransformInfo( LLVMTargetMachineRef tm, LLVMValueRef function, LibLLVMTargetTransformInfoRef* outRetVal )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        if (tm == nullptr)
+        {
+            return LLVMCreateStringError("tm is null");
+        }
+
+        auto* fn = dyn_cast_or_null<Function>(unwrap(function));
+        if (fn == nullptr)
+        {
+            return LLVMCreateStringError("function is not a Function");
+        }
+
+        if (fn->getParent() == nullptr)
+        {
+            return LLVMCreateStringError("function is not in a module");
+        }
+
+        *outRetVal = wrap(new TargetTransformInfoHolder(*reinterpret_cast<TargetMachine*>(tm), *fn));
+        return nullptr;
+    }
+
+    void LibLLVMDisposeTargetTransformInfo( LibLLVMTargetTransformInfoRef tti )
+    {
+        delete unwrap(tti);
+    }
+
+    void LibLLVMTargetTransformInfoGetProperties( LibLLVMTargetTransformInfoRef tti, LibLLVMTargetTransformProperties* properties )
+    {
+        TargetTransformInfo const& info = unwrap(tti)->TTI;
+        LibLLVMTargetTransformProperties& props = *properties;
+        props.ScalarRegisterBitWidth = info.getRegisterBitWidth(TargetTransformInfo::RGK_Scalar).getFixedValue();
+        props.FixedVectorRegisterBitWidth = info.getRegisterBitWidth(TargetTransformInfo::RGK_FixedWidthVector).getFixedValue();
+        props.SupportsScalableVectors = info.supportsScalableVectors();
+        props.ScalableVectorRegisterBitWidth = props.SupportsScalableVectors
+                                             ? info.getRegisterBitWidth(TargetTransformInfo::RGK_ScalableVector).getKnownMinValue()
+                                             : 0;
+        props.MinVectorRegisterBitWidth = info.getMinVectorRegisterBitWidth();
+        props.NumScalarRegisters = info.getNumberOfRegisters(info.getRegisterClassForType(/*Vector*/ false));
+        props.NumVectorRegisters = info.getNumberOfRegisters(info.getRegisterClassForType(/*Vector*/ true));
+        props.CacheLineSize = info.getCacheLineSize();
+        props.L1DataCacheSize = info.getCacheSize(TargetTransformInfo::CacheLevel::L1D).value_or(0);
+        props.L2DataCacheSize = info.getCacheSize(TargetTransformInfo::CacheLevel::L2D).value_or(0);
+        props.PrefetchDistance = info.getPrefetchDistance();
+        props.MaxScalarInterleaveFactor = info.getMaxInterleaveFactor(ElementCount::getFixed(1));
+    }
+
+    uint32_t LibLLVMTargetTransformInfoGetMaxInterleaveFactor( LibLLVMTargetTransformInfoRef tti, uint32_t vectorizationFactor, LLVMBool scalable )
+    {
+        return unwrap(tti)->TTI.getMaxInterleaveFactor(ElementCount::get(vectorizationFactor, scalable));
+    }
+
+    LLVMErrorRef LibLLVMTargetTransformInfoGetCosts( LibLLVMTargetTransformInfoRef tti
+                                                   , LibLLVMTargetCostKind costKind
+                                                   , LibLLVMCostQuery const* queries
+                                                   , size_t numQueries
+                                                   , LibLLVMCostResult* results
+                                                   )
+    {
+        if ((queries == nullptr || results == nullptr) && numQueries > 0)
+        {
+            return LLVMCreateStringError("queries or results is null");
+        }
+
+        TargetTransformInfoHolder const& holder = *unwrap(tti);
+        auto kind = static_cast<TargetTransformInfo::TargetCostKind>(costKind);
+        for (size_t i = 0; i < numQueries; ++i)
+        {
+            Expected<InstructionCost> cost = GetCost(holder, kind, queries[i]);
+            if (!cost)
+            {
+                std::fill(results, results + numQueries, LibLLVMCostResult{ 0, false });
+                return wrap(createStringError(inconvertibleErrorCode(), "Query %zu: %s", i, toString(cost.takeError()).c_str()));
+            }
+
+            results[i].IsValid = cost->isValid();
+            results[i].Cost = cost->isValid() ? *cost->getValue() : 0;
+        }
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,547 @@
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "libllvm-c/ThroughputBindings.h"
+#include "libllvm-c/TargetRegistrationBindings.h"
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/bit.h>
+#include <llvm/MC/MCAsmInfo.h>
+#include <llvm/MC/MCContext.h>
+#include <llvm/MC/MCDisassembler/MCDisassembler.h>
+#include <llvm/MC/MCInst.h>
+#include <llvm/MC/MCInstrAnalysis.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCObjectFileInfo.h>
+#include <llvm/MC/MCParser/MCAsmParser.h>
+#include <llvm/MC/MCParser/MCTargetAsmParser.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCSchedule.h>
+#include <llvm/MC/MCStreamer.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/MCTargetOptions.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/MCA/Context.h>
+#include <llvm/MCA/CustomBehaviour.h>
+#include <llvm/MCA/HWEventListener.h>
+#include <llvm/MCA/InstrBuilder.h>
+#include <llvm/MCA/Pipeline.h>
+#include <llvm/MCA/SourceMgr.h>
+#include <llvm/MCA/Support.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/TargetParser/Triple.h>
+
+using namespace llvm;
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<LibLLVMThroughputSummary>, "LibLLVMThroughputSummary must be blittable for stable ABI binding");
+    static_assert(std::is_trivially_copyable_v<LibLLVMResourcePressure>, "LibLLVMResourcePressure must be blittable for stable ABI binding");
+
+    // Same default as llvm-mca
+    constexpr uint32_t DefaultIterations = 100;
+
+    // Same default as llvm-mca for the latency of calls, which the scheduling models do not describe
+    constexpr unsigned CallLatency = 100;
+
+    // Streamer that only collects the instructions of parsed assembly (see: llvm-mca MCStreamerWrapper)
+    class InstructionCollector final
+        : public MCStreamer
+    {
+    public:
+        InstructionCollector(MCContext& ctx, std::vector<MCInst>& instructions)
+            : MCStreamer(ctx)
+            , Instructions(instructions)
+        {
+        }
+
+        void emitInstruction(MCInst const& inst, MCSubtargetInfo const& /*sti*/) override
+        {
+            Instructions.push_back(inst);
+        }
+
+        bool emitSymbolAttribute(MCSymbol* /*symbol*/, MCSymbolAttr /*attribute*/) override
+        {
+            return true;
+        }
+
+        void emitCommonSymbol(MCSymbol* /*symbol*/, uint64_t /*size*/, Align /*byteAlignment*/) override
+        {
+        }
+
+        void emitZerofill(MCSection* /*section*/, MCSymbol* /*symbol*/, uint64_t /*size*/, Align /*byteAlignment*/, SMLoc /*loc*/) override
+        {
+        }
+
+        void beginCOFFSymbolDef(MCSymbol const* /*symbol*/) override
+        {
+        }
+
+        void emitCOFFSymbolStorageClass(int /*storageClass*/) override
+        {
+        }
+
+        void emitCOFFSymbolType(int /*type*/) override
+        {
+        }
+
+        void endCOFFSymbolDef() override
+        {
+        }
+
+    private:
+        std::vector<MCInst>& Instructions;
+    };
+
+    // Accumulates the cycles each unit of each processor resource is used (see: llvm-mca ResourcePressureView)
+    class ResourcePressureListener final
+        : public mca::HWEventListener
+    {
+    public:
+        ResourcePressureListener(MCSchedModel const& schedModel)
+            : FirstUnit(schedModel.getNumProcResourceKinds(), UINT32_MAX)
+        {
+            uint32_t numUnits = 0;
+            for (unsigned i = 0; i < schedModel.getNumProcResourceKinds(); ++i)
+            {
+                // Groups and invalid resources (no units) are not tracked as they are resolved to a unit when used
+                MCProcResourceDesc const& resource = *schedModel.getProcResource(i);
+                if (resource.SubUnitsIdxBegin != nullptr || resource.NumUnits == 0)
+                {
+                    continue;
+                }
+
+                FirstUnit[i] = numUnits;
+                numUnits += resource.NumUnits;
+            }
+
+            Cycles.resize(numUnits);
+        }
+
+        void onEvent(mca::HWInstructionEvent const& event) override
+        {
+            if (event.Type != mca::HWInstructionEvent::Issued)
+            {
+                return;
+            }
+
+            auto const& issued = static_cast<mca::HWInstructionIssuedEvent const&>(event);
+            for (auto const& [resource, cycles] : issued.UsedResources)
+            {
+                // resource is the index of the processor resource and a mask of the unit used
+                if (resource.first >= FirstUnit.size() || FirstUnit[resource.first] == UINT32_MAX)
+                {
+                    continue;
+                }
+
+                Cycles[FirstUnit[resource.first] + countr_zero(resource.second)] += static_cast<double>(cycles.getNumerator()) / cycles.getDenominator();
+            }
+        }
+
+        std::vector<uint32_t> FirstUnit;    // index of the first unit of each resource in Cycles
+        std::vector<double> Cycles;
+    };
+
+    struct ThroughputResults
+    {
+        LibLLVMThroughputSummary Summary = {};
+        std::vector<LibLLVMResourcePressure> Pressure;
+    };
+
+    // The target descriptions are created once and shared; Each analysis creates its own MCContext and
+    // mca pipeline, which are not thread safe.
+    class ThroughputAnalyzer
+    {
+    public:
+        Triple TargetTriple;
+        Target const* TheTarget = nullptr;
+        MCTargetOptions Options;
+        std::unique_ptr<MCRegisterInfo const> MRI;
+        std::unique_ptr<MCAsmInfo const> MAI;
+        std::unique_ptr<MCSubtargetInfo const> STI;
+        std::unique_ptr<MCInstrInfo const> MII;
+        std::unique_ptr<MCInstrAnalysis const> MCIA;
+
+        Expected<std::unique_ptr<ThroughputResults>> AnalyzeAsm(StringRef text, uint32_t iterations) const
+        {
+            std::string diagnostics;
+            raw_string_ostream diagStream(diagnostics);
+            SourceMgr srcMgr;
+            srcMgr.setDiagHandler([](SMDiagnostic const& diag, void* context)
+                {
+                    diag.print(nullptr, *static_cast<raw_ostream*>(context), /*ShowColors*/ false);
+                }, &diagStream);
+
+            // Copied as the lexer requires a nul terminator that the caller's text may not have
+            srcMgr.AddNewSourceBuffer(MemoryBuffer::getMemBufferCopy(text, "<asm>"), SMLoc());
+
+            // The context owns the expressions of the operands so it MUST remain alive for the analysis
+            MCContext ctx(TargetTriple, MAI.get(), MRI.get(), STI.get(), &srcMgr, &Options);
+            std::unique_ptr<MCObjectFileInfo> mofi(TheTarget->createMCObjectFileInfo(ctx, /*PIC*/ false));
+            ctx.setObjectFileInfo(mofi.get());
+
+            std::vector<MCInst> instructions;
+            InstructionCollector collector(ctx, instructions);
+            std::unique_ptr<MCAsmParser> parser(createMCAsmParser(srcMgr, ctx, collector, *MAI));
+            std::unique_ptr<MCTargetAsmParser> targetParser(TheTarget->createMCAsmParser(*STI, *parser, *MII, Options));
+            if (!targetParser)
+            {
+                return createStringError(inconvertibleErrorCode(), "Unable to create an asm parser for the target; is the AsmParser registered?");
+            }
+
+            parser->setTargetParser(*targetParser);
+            if (parser->Run(/*NoInitialTextSection*/ false) || ctx.hadError())
+            {
+                diagStream.flush();
+                std::string message = StringRef(diagnostics).rtrim().str();
+                return createStringError(inconvertibleErrorCode(), message.empty() ? "Assembly failed" : message.c_str());
+            }
+
+            return Analyze(instructions, iterations);
+        }
+
+        Expected<std::unique_ptr<ThroughputResults>> AnalyzeCode(ArrayRef<uint8_t> bytes, uint32_t iterations) const
+        {
+            MCContext ctx(TargetTriple, MAI.get(), MRI.get(), STI.get(), nullptr, &Options);
+            std::unique_ptr<MCDisassembler const> disAsm(TheTarget->createMCDisassembler(*STI, ctx));
+            if (!disAsm)
+            {
+                return createStringError(inconvertibleErrorCode(), "Unable to create a disassembler for the target; is the disassembler registered?");
+            }
+
+            std::vector<MCInst> instructions;
+            for (uint64_t offset = 0; offset < bytes.size();)
+            {
+                MCInst inst;
+                uint64_t size = 0;
+                if (disAsm->getInstruction(inst, size, bytes.slice(offset), offset, nulls()) != MCDisassembler::Success || size == 0)
+                {
+                    return createStringError(inconvertibleErrorCode(), "Invalid instruction encoding at offset %llu", static_cast<unsigned long long>(offset));
+                }
+
+                instructions.push_back(inst);
+                offset += size;
+            }
+
+            return Analyze(instructions, iterations);
+        }
+
+    private:
+        // Analysis follows llvm-mca for a single code region with the default pipeline options
+        Expected<std::unique_ptr<ThroughputResults>> Analyze(ArrayRef<MCInst> instructions, uint32_t iterations) const
+        {
+            if (instructions.empty())
+            {
+                return createStringError(inconvertibleErrorCode(), "No instructions to analyze");
+            }
+
+            if (iterations == 0)
+            {
+                iterations = DefaultIterations;
+            }
+
+            MCSchedModel const& schedModel = STI->getSchedModel();
+            std::unique_ptr<mca::InstrPostProcess> postProcess(TheTarget->createInstrPostProcess(*STI, *MII));
+            if (!postProcess)
+            {
+                postProcess = std::make_unique<mca::InstrPostProcess>(*STI, *MII);
+            }
+
+            std::unique_ptr<mca::InstrumentManager> instrumentManager(TheTarget->createInstrumentManager(*STI, *MII));
+            if (!instrumentManager)
+            {
+                instrumentManager = std::make_unique<mca::InstrumentManager>(*STI, *MII);
+            }
+
+            mca::InstrBuilder builder(*STI, *MII, *MRI, MCIA.get(), *instrumentManager, CallLatency);
+            SmallVector<mca::Instrument*> instruments;
+            std::vector<std::unique_ptr<mca::Instruction>> lowered;
+            for (MCInst const& mcInst : instructions)
+            {
+                Expected<std::unique_ptr<mca::Instruction>> inst = builder.createInstruction(mcInst, instruments);
+                if (!inst)
+                {
+                    return inst.takeError();
+                }
+
+                postProcess->postProcessInstruction(*inst, mcInst);
+                lowered.push_back(std::move(*inst));
+            }
+
+            // Block reciprocal throughput is computed from the resources used by one iteration (see: llvm-mca SummaryView)
+            unsigned numResourceKinds = schedModel.getNumProcResourceKinds();
+            SmallVector<uint64_t> resourceMasks(numResourceKinds);
+            mca::computeProcResourceMasks(schedModel, resourceMasks);
+            std::vector<unsigned> resourceIds(numResourceKinds, 0);
+            for (unsigned i = 1; i < numResourceKinds; ++i)
+            {
+                resourceIds[mca::getResourceStateIndex(resourceMasks[i])] = i;
+            }
+
+            std::vector<unsigned> resourceUsage(numResourceKinds, 0);
+            unsigned numMicroOps = 0;
+            for (std::unique_ptr<mca::Instruction> const& inst : lowered)
+            {
+                mca::InstrDesc const& desc = inst->getDesc();
+                numMicroOps += desc.NumMicroOps;
+                for (auto const& [mask, usage] : desc.Resources)
+                {
+                    if (usage.size() > 0)
+                    {
+                        resourceUsage[resourceIds[mca::getResourceStateIndex(mask)]] += usage.size();
+                    }
+                }
+            }
+
+            mca::CircularSourceMgr source(lowered, iterations);
+            std::unique_ptr<mca::CustomBehaviour> customBehaviour(TheTarget->createCustomBehaviour(*STI, source, *MII));
+            if (!customBehaviour)
+            {
+                customBehaviour = std::make_unique<mca::CustomBehaviour>(*STI, source, *MII);
+            }
+
+            mca::Context context(*MRI, *STI);
+            mca::PipelineOptions pipelineOptions( /*UOPQSize*/ 0
+                                                , /*DecThr*/ 0
+                                                , /*DW*/ 0
+                                                , /*RFS*/ 0
+                                                , /*LQS*/ 0
+                                                , /*SQS*/ 0
+                                                , /*NoAlias*/ true
+                                                );
+
+            std::unique_ptr<mca::Pipeline> pipeline = schedModel.isOutOfOrder()
+                                                    ? context.createDefaultPipeline(pipelineOptions, source, *customBehaviour)
+                                                    : context.createInOrderPipeline(pipelineOptions, source, *customBehaviour);
+
+            ResourcePressureListener listener(schedModel);
+            pipeline->addEventListener(&listener);
+            Expected<unsigned> cycles = pipeline->run();
+            if (!cycles)
+            {
+                return cycles.takeError();
+            }
+
+            auto results = std::make_unique<ThroughputResults>();
+            LibLLVMThroughputSummary& summary = results->Summary;
+            summary.Iterations = iterations;
+            summary.NumInstructions = static_cast<uint32_t>(lowered.size());
+            summary.TotalCycles = *cycles;
+            summary.TotalMicroOps = static_cast<uint64_t>(numMicroOps) * iterations;
+            summary.DispatchWidth = schedModel.IssueWidth;
+            summary.IPC = *cycles == 0 ? 0.0 : static_cast<double>(summary.NumInstructions) * iterations / *cycles;
+            summary.MicroOpsPerCycle = *cycles == 0 ? 0.0 : static_cast<double>(summary.TotalMicroOps) / *cycles;
+            summary.BlockReciprocalThroughput = mca::computeBlockRThroughput(schedModel, summary.DispatchWidth, numMicroOps, resourceUsage);
+
+            for (unsigned i = 0; i < numResourceKinds; ++i)
+            {
+                if (listener.FirstUnit[i] == UINT32_MAX)
+                {
+                    continue;
+                }
+
+                MCProcResourceDesc const& resource = *schedModel.getProcResource(i);
+                StringRef name(resource.Name);
+                for (uint32_t unit = 0; unit < resource.NumUnits; ++unit)
+                {
+                    results->Pressure.push_back({ name.data()
+                                                , name.size()
+                                                , i
+                                                , unit
+                                                , listener.Cycles[listener.FirstUnit[i] + unit] / iterations
+                                                });
+                }
+            }
+
+            return std::move(results);
+        }
+    };
+
+    inline StringRef GetStringRef(char const* str, size_t len)
+    {
+        return str == nullptr ? StringRef() : StringRef(str, len);
+    }
+
+    inline ThroughputAnalyzer* unwrap(LibLLVMThroughputAnalyzerRef analyzer)
+    {
+        return reinterpret_cast<ThroughputAnalyzer*>(analyzer);
+    }
+
+    inline LibLLVMThroughputAnalyzerRef wrap(ThroughputAnalyzer* analyzer)
+    {
+        return reinterpret_cast<LibLLVMThroughputAnalyzerRef>(analyzer);
+    }
+
+    inline ThroughputResults* unwrap(LibLLVMThroughputResultsRef results)
+    {
+        return reinterpret_cast<ThroughputResults*>(results);
+    }
+
+    inline LibLLVMThroughputResultsRef wrap(ThroughputResults* results)
+    {
+        return reinterpret_cast<LibLLVMThroughputResultsRef>(results);
+    }
+
+    LLVMErrorRef ReturnResults(Expected<std::unique_ptr<ThroughputResults>> results, LibLLVMThroughputResultsRef* outResults)
+    {
+        if (!results)
+        {
+            return wrap(results.takeError());
+        }
+
+        *outResults = wrap(results->release());
+        return nullptr;
+    }
+}
+
+extern "C"
+{
+    LLVMErrorRef LibLLVMCreateThroughputAnalyzer( char const* triple
+                                                , size_t tripleLen
+                                                , char const* cpu
+                                                , size_t cpuLen
+                                                , char const* features
+                                                , size_t featuresLen
+                                                , LibLLVMThroughputAnalyzerRef* outRetVal
+                                                )
+    {
+        if (outRetVal == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outRetVal' is null!");
+        }
+
+        *outRetVal = nullptr;
+        StringRef tripleRef = GetStringRef(triple, tripleLen);
+        if (tripleRef.empty())
+        {
+            return LLVMCreateStringError("triple is null or empty");
+        }
+
+        StringRef cpuRef = GetStringRef(cpu, cpuLen);
+        if (cpuRef.empty())
+        {
+            return LLVMCreateStringError("cpu is null or empty");
+        }
+
+        // The target specific parts of the analysis (i.e. the X86 post processing or the AMDGPU custom behaviour) are
+        // registered separately from the target, as llvm-mca does, otherwise the generic fallbacks are used.
+        static std::once_flag targetMCAsInitialized;
+        std::call_once(targetMCAsInitialized, InitializeAllTargetMCAs);
+
+        // Both the asm parser and the disassembler are used; an unknown target is reported by the lookup
+        LLVMConsumeError(LibLLVMRegisterPendingTargetForTriple(triple, tripleLen, static_cast<LibLLVMTargetRegistrationKind>(TargetRegistration_AsmParser | TargetRegistration_Disassembler)));
+
+        std::string errMsg;
+        Target const* target = TargetRegistry::lookupTarget(tripleRef.str(), errMsg);
+        if (target == nullptr)
+        {
+            return LLVMCreateStringError(errMsg.c_str());
+        }
+
+        auto retVal = std::make_unique<ThroughputAnalyzer>();
+        retVal->TargetTriple = Triple(tripleRef);
+        retVal->TheTarget = target;
+        retVal->MRI.reset(target->createMCRegInfo(tripleRef));
+        if (!retVal->MRI)
+        {
+            return LLVMCreateStringError("Unable to create register info for the target");
+        }
+
+        retVal->MAI.reset(target->createMCAsmInfo(*retVal->MRI, tripleRef, retVal->Options));
+        if (!retVal->MAI)
+        {
+            return LLVMCreateStringError("Unable to create asm info for the target");
+        }
+
+        retVal->STI.reset(target->createMCSubtargetInfo(tripleRef, cpuRef, GetStringRef(features, featuresLen)));
+        if (!retVal->STI)
+        {
+            return LLVMCreateStringError("Unable to create subtarget info for the target");
+        }
+
+        if (!retVal->STI->isCPUStringValid(cpuRef))
+        {
+            return LLVMCreateStringError("cpu is not valid for the target");
+        }
+
+        if (!retVal->STI->getSchedModel().hasInstrSchedModel())
+        {
+            return LLVMCreateStringError("cpu does not have a scheduling model");
+        }
+
+        retVal->MII.reset(target->createMCInstrInfo());
+        if (!retVal->MII)
+        {
+            return LLVMCreateStringError("Unable to create instruction info for the target");
+        }
+
+        retVal->MCIA.reset(target->createMCInstrAnalysis(retVal->MII.get()));
+        *outRetVal = wrap(retVal.release());
+        return nullptr;
+    }
+
+    void LibLLVMDisposeThroughputAnalyzer( LibLLVMThroughputAnalyzerRef analyzer )
+    {
+        delete unwrap(analyzer);
+    }
+
+    LLVMErrorRef LibLLVMAnalyzeThroughputAsm( LibLLVMThroughputAnalyzerRef analyzer
+                                            , char const* text
+                                            , size_t textLen
+                                            , uint32_t iterations
+                                            , LibLLVMThroughputResultsRef* outResults
+                                            )
+    {
+        if (outResults == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outResults' is null!");
+        }
+
+        *outResults = nullptr;
+        return ReturnResults(unwrap(analyzer)->AnalyzeAsm(GetStringRef(text, textLen), iterations), outResults);
+    }
+
+    LLVMErrorRef LibLLVMAnalyzeThroughputCode( LibLLVMThroughputAnalyzerRef analyzer
+                                             , uint8_t const* bytes
+                                             , uint64_t numBytes
+                                             , uint32_t iterations
+                                             , LibLLVMThroughputResultsRef* outResults
+                                             )
+    {
+        if (outResults == nullptr)
+        {
+            return LLVMCreateStringError("Out parameter 'outResults' is null!");
+        }
+
+        *outResults = nullptr;
+        if (bytes == nullptr && numBytes > 0)
+        {
+            return LLVMCreateStringError("bytes is null");
+        }
+
+        ArrayRef<uint8_t> code(bytes, static_cast<size_t>(numBytes));
+        return ReturnResults(unwrap(analyzer)->AnalyzeCode(code, iterations), outResults);
+    }
+
+    void LibLLVMDisposeThroughputResults( LibLLVMThroughputResultsRef results )
+    {
+        delete unwrap(results);
+    }
+
+    void LibLLVMThroughputResultsGetSummary( LibLLVMThroughputResultsRef results, LibLLVMThroughputSummary* summary )
+    {
+        *summary = unwrap(results)->Summary;
+    }
+
+    LibLLVMResourcePressure const* LibLLVMThroughputResultsGetResourcePressure( LibLLVMThroughputResultsRef results, size_t* numResources )
+    {
+        *numResources = unwrap(results)->Pressure.size();
+        return unwrap(results)->Pressure.data();
+    }
+}
@@ -1,4 +1,12 @@
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <cstring>
+#include <type_traits>
+
 #include <llvm-c/Core.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/TargetParser/Triple.h>
 #include <llvm/Support/CBindingWrapping.h>
 #include <llvm/TargetParser/ARMTargetParser.h>
@@ -8,6 +16,103 @@ using namespace llvm;
 
 DEFINE_SIMPLE_CONVERSION_FUNCTIONS( Triple, LibLLVMTripleRef )
 
+namespace
+{
+    // Process wide table of interned triples
+    // The table maps the exact string provided to the interned triple so that a repeated
+    // intern of the same string doesn't even need to normalize it. Triples are owned by
+    // the normalized form so that all aliases of the same triple share one instance.
+    class TripleInternTable
+    {
+    public:
+        Triple const* Intern( StringRef str )
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock( Lock );
+                auto it = ByName.find( str );
+                if ( it != ByName.end( ) )
+                {
+                    return it->second;
+                }
+            }
+
+            // Normalize outside of the lock, it's the expensive part
+            std::string normalized = Triple::normalize( str );
+
+            std::unique_lock<std::shared_mutex> lock( Lock );
+            auto& owned = ByNormalizedName[ normalized ];
+            if ( !owned )
+            {
+                owned = std::make_unique<Triple>( normalized );
+                Interned.insert( owned.get( ) );
+            }
+
+            // If another thread won the race for the same name this is a NOP
+            ByName.try_emplace( str, owned.get( ) );
+            return owned.get( );
+        }
+
+        bool IsInterned( Triple const* pTriple )
+        {
+            std::shared_lock<std::shared_mutex> lock( Lock );
+            return Interned.contains( pTriple );
+        }
+
+        static TripleInternTable& Instance( )
+        {
+            static TripleInternTable table;
+            return table;
+        }
+
+    private:
+        std::shared_mutex Lock;
+        StringMap<Triple const*> ByName;
+        StringMap<std::unique_ptr<Triple>> ByNormalizedName;
+        DenseSet<Triple const*> Interned;
+    };
+
+    LibLLVMTripleVersion make_c_version( VersionTuple const& ver )
+    {
+        return LibLLVMTripleVersion{ ver.getMajor( )
+                                   , ver.getMinor( ).value_or( 0 )
+                                   , ver.getSubminor( ).value_or( 0 )
+                                   , ver.getBuild( ).value_or( 0 )
+                                   };
+    }
+
+    uint32_t GetPointerBitWidth( Triple const& triple )
+    {
+        if ( triple.isArch64Bit( ) )
+        {
+            return 64;
+        }
+
+        if ( triple.isArch32Bit( ) )
+        {
+            return 32;
+        }
+
+        return triple.isArch16Bit( ) ? 16 : 0;
+    }
+
+    void Decode( Triple const& triple, LibLLVMDecodedTriple& decoded )
+    {
+        decoded.ArchType = ( LibLLVMTripleArchType )triple.getArch( );
+        decoded.SubArchType = ( LibLLVMTripleSubArchType )triple.getSubArch( );
+        decoded.VendorType = ( LibLLVMTripleVendorType )triple.getVendor( );
+        decoded.OsType = ( LibLLVMTripleOSType )triple.getOS( );
+        decoded.EnvironmentType = ( LibLLVMTripleEnvironmentType )triple.getEnvironment( );
+        decoded.ObjectFormatType = ( LibLLVMTripleObjectFormatType )triple.getObjectFormat( );
+        decoded.OsVersion = make_c_version( triple.getOSVersion( ) );
+        decoded.EnvironmentVersion = make_c_version( triple.getEnvironmentVersion( ) );
+        decoded.PointerBitWidth = GetPointerBitWidth( triple );
+        decoded.IsLittleEndian = triple.isLittleEndian( );
+        decoded.HasEnvironment = triple.hasEnvironment( );
+    }
+
+    static_assert( std::is_trivially_copyable_v<LibLLVMDecodedTriple>, "LibLLVMDecodedTriple must be blittable for stable ABI binding" );
+}
+
 extern "C"
 {
     LibLLVMTripleRef LibLLVMParseTriple( char const* triple )
@@ -17,7 +122,11 @@ extern "C"
 
     void LibLLVMDisposeTriple( LibLLVMTripleRef triple )
     {
-        delete unwrap( triple );
+        Triple* pTriple = unwrap( triple );
+        if ( !TripleInternTable::Instance( ).IsInterned( pTriple ) )
+        {
+            delete pTriple;
+        }
     }
 
     LibLLVMTripleRef LibLLVMGetHostTriple( )
@@ -34,7 +143,62 @@ extern "C"
 
     LLVMBool LibLLVMTripleOpEqual( LibLLVMTripleRef lhs, LibLLVMTripleRef rhs )
     {
-        return *unwrap( lhs ) == *unwrap( rhs );
+        return lhs == rhs || *unwrap( lhs ) == *unwrap( rhs );
+    }
+
+    char const* LibLLVMTripleGetString( LibLLVMTripleRef triple, /*[Out]*/ size_t* len )
+    {
+        std::string const& str = unwrap( triple )->str( );
+        *len = str.size( );
+        return str.data( );
+    }
+
+    LLVMErrorRef LibLLVMTripleDecode( LibLLVMTripleRef triple, /*[out, byref]*/ LibLLVMDecodedTriple* pDecoded )
+    {
+        if ( pDecoded == nullptr )
+        {
+            return LLVMCreateStringError( "Out ref parameter 'pDecoded' is null!" );
+        }
+
+        Decode( *unwrap( triple ), *pDecoded );
+        return nullptr;
+    }
+
+    LLVMErrorRef LibLLVMTripleDecodeStrings( char const* const* triples, size_t numTriples, /*(OUT, LibLLVMDecodedTriple[numTriples])*/ LibLLVMDecodedTriple* results )
+    {
+        if ( numTriples > 0 && ( triples == nullptr || results == nullptr ) )
+        {
+            return LLVMCreateStringError( "triples or results array is null" );
+        }
+
+        TripleInternTable& table = TripleInternTable::Instance( );
+        for ( size_t i = 0; i < numTriples; ++i )
+        {
+            if ( triples[ i ] == nullptr )
+            {
+                return LLVMCreateStringError( "triples array contains a null string" );
+            }
+
+            Decode( *table.Intern( StringRef( triples[ i ], std::strlen( triples[ i ] ) ) ), results[ i ] );
+        }
+
+        return nullptr;
+    }
+
+    LibLLVMTripleRef LibLLVMInternTriple( char const* triple, size_t len )
+    {
+        return wrap( TripleInternTable::Instance( ).Intern( StringRef( triple, len ) ) );
+    }
+
+    LibLLVMTripleRef LibLLVMGetInternedHostTriple( )
+    {
+        static Triple const* pHostTriple = TripleInternTable::Instance( ).Intern( LLVM_HOST_TRIPLE );
+        return wrap( pHostTriple );
+    }
+
+    LLVMBool LibLLVMTripleIsInterned( LibLLVMTripleRef triple )
+    {
+        return TripleInternTable::Instance( ).IsInterned( unwrap( triple ) );
     }
 
     LibLLVMTripleArchType LibLLVMTripleGetArchType( LibLLVMTripleRef triple )
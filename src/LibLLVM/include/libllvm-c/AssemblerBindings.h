@@ -0,0 +1,68 @@
+#ifndef _LIBLLVM_ASSEMBLER_BINDINGS_H_
+#define _LIBLLVM_ASSEMBLER_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // Assembles textual assembly into object files in memory. The target for the triple MUST have the AsmParser
+    // and the TargetMachine (for the code emitter and object writer) registered (see: LibLLVMRegisterTarget()).
+    // The target descriptions are created once for the assembler and shared by all uses of it; an assembler is
+    // immutable once created so it is safe to use from multiple threads at once.
+    typedef struct LibLLVMOpaqueAssembler* LibLLVMAssemblerRef;
+
+    // Creates an assembler; none of the strings are required to be nul terminated and the cpu and features
+    // are optional (null or empty)
+    LLVMErrorRef LibLLVMCreateAssembler( char const* triple
+                                       , size_t tripleLen
+                                       , char const* cpu
+                                       , size_t cpuLen
+                                       , char const* features
+                                       , size_t featuresLen
+                                       , /*[out]*/ LibLLVMAssemblerRef* outRetVal
+                                       );
+
+    void LibLLVMDisposeAssembler( LibLLVMAssemblerRef assembler );
+
+    // Assembles text into an object file in the format of the triple; The result MUST be disposed
+    // with LLVMDisposeMemoryBuffer(). Failures include all of the diagnostics from the assembly.
+    LLVMErrorRef LibLLVMAssemblerAssemble( LibLLVMAssemblerRef assembler
+                                         , char const* text
+                                         , size_t textLen
+                                         , /*[out]*/ LLVMMemoryBufferRef* outObject
+                                         );
+
+    // Convenience for a single use, equivalent to creating an assembler, assembling the text and disposing of
+    // the assembler. Use an assembler directly to avoid repeating the target setup for multiple snippets.
+    LLVMErrorRef LibLLVMAssembleToObject( char const* triple
+                                        , size_t tripleLen
+                                        , char const* cpu
+                                        , size_t cpuLen
+                                        , char const* features
+                                        , size_t featuresLen
+                                        , char const* text
+                                        , size_t textLen
+                                        , /*[out]*/ LLVMMemoryBufferRef* outObject
+                                        );
+
+    typedef struct LibLLVMAssemblySnippet
+    {
+        char const* Name;           // Optional name used in diagnostics and for the buffer; NOT required to be nul terminated
+        size_t NameLen;
+        char const* Text;           // NOT required to be nul terminated
+        size_t TextLen;
+    } LibLLVMAssemblySnippet;
+
+    // Assembles independent snippets in parallel (one task per snippet); outObjects is an array with at least
+    // numSnippets elements that receives the object for each snippet, which MUST be disposed with
+    // LLVMDisposeMemoryBuffer(). If any snippet fails the result is an error (the errors of all snippets are
+    // joined) and all elements of outObjects are null.
+    LLVMErrorRef LibLLVMAssembleBatch( LibLLVMAssemblerRef assembler
+                                     , LibLLVMAssemblySnippet const* snippets
+                                     , size_t numSnippets
+                                     , /*(OUT, LLVMMemoryBufferRef[numSnippets])*/ LLVMMemoryBufferRef* outObjects
+                                     );
+LLVM_C_EXTERN_C_END
+
+#endif
@@ -48,6 +48,21 @@ LLVM_C_EXTERN_C_BEGIN
         LibLLVMAttributeAllowedOn AllowedOn;
     };
 
+    // Entry in the table of all enumerated attributes; Name is a static constant
+    // string (NOT nul terminated) so no deallocation is needed.
+    struct LibLLVMAttributeTableEntry
+    {
+        char const* Name;
+        size_t NameLen;
+        LibLLVMAttributeInfo Info;
+    };
+
+    // Gets the table of information for ALL enumerated attributes, indexed by the attribute ID (AttrKind).
+    // The table is built only once per process and lives for the lifetime of the process so the result
+    // is NOT disposed. Entry 0 is the info for string attributes (ID 0) and has no name. Returns null if
+    // numEntries is null.
+    LibLLVMAttributeTableEntry const* LibLLVMGetAttributeInfoTable(/*[Out]*/ size_t* numEntries);
+
     // Gets the number of attributes known by this implementation/runtime
     // The value this returns is used to allocate and array of `char const*`
     // to use with the LibLLVMGetKnownAttributeNames() API.
@@ -61,12 +76,61 @@ LLVM_C_EXTERN_C_BEGIN
     // on the fly so it must be disposed of when no longer needed.
     char const* LibLLVMAttributeToString( LLVMAttributeRef attribute );
 
+    // Formats an attribute into a caller supplied buffer, which avoids the allocation and
+    // separate dispose of the result of LibLLVMAttributeToString(). The attribute is formatted
+    // directly into the buffer (the same text as LibLLVMAttributeToString()) without allocating.
+    // The return is the number of characters required, INCLUDING the terminating '\0'. If the
+    // return is > bufferLen then the buffer is too small and the contents of the buffer are
+    // undefined; the caller should call again with a buffer of at least the returned size.
+    size_t LibLLVMAttributeToStringBuffer( LLVMAttributeRef attribute, char* buffer, size_t bufferLen );
+
+    // Formats ALL attributes of a function or call site into a single packed buffer. Each attribute
+    // string is terminated by a '\0' and they are in the same order as the records produced by
+    // LibLLVMGetAttributeRecords(). The size convention is the same as LibLLVMAttributeToStringBuffer();
+    // The return is the total number of characters required, including ALL terminators. A value that
+    // is not a function or call site has no attributes and returns 0.
+    size_t LibLLVMAttributesToStringBuffer( LLVMValueRef /*Function|CallBase*/ functionOrCall, char* buffer, size_t bufferLen );
+
     // Sadly these two kinds of attributes were left out of the official LLVM-C API
     LLVMBool LibLLVMIsConstantRangeAttribute(LLVMAttributeRef atrribute);
     LLVMBool LibLLVMIsConstantRangeListAttribute(LLVMAttributeRef atrribute);
 
     LLVMErrorRef LibLLVMGetAttributeInfo(char* attribName, size_t nameLen, /*[out, byref]*/ LibLLVMAttributeInfo* pInfo);
 
+    // Flat record of a single attribute at a given index in an attribute list
+    // Index uses the same values as LLVMAttributeIndex (LLVMAttributeReturnIndex, LLVMAttributeFunctionIndex,
+    // or 1 + the parameter number). Which value members are used depends on the LibLLVMAttributeArgKind
+    // for the ID (see: LibLLVMGetAttributeInfoTable()).
+    // When AttributeRef is non-null it is used as-is and all other value members are ignored. This
+    // allows for attributes that have no flat representation (i.e. ConstantRange and ConstantRangeList).
+    struct LibLLVMAttributeRecord
+    {
+        uint32_t Index;
+        uint32_t ID;                // 0 for string attributes
+        uint64_t IntValue;          // LibLLVMAttributeArgKind_Int
+        LLVMTypeRef TypeValue;      // LibLLVMAttributeArgKind_Type
+        char const* StringKind;     // LibLLVMAttributeArgKind_String
+        size_t StringKindLen;
+        char const* StringValue;    // LibLLVMAttributeArgKind_String
+        size_t StringValueLen;
+        LLVMAttributeRef AttributeRef;
+    };
+
+    // Builds a single attribute list from an array of records and sets it as the complete list of
+    // attributes for a function or call site (any existing attributes are replaced). Records are
+    // NOT required to be sorted by index. This is a single operation regardless of the number of
+    // records instead of re-building the list for each attribute added.
+    LLVMErrorRef LibLLVMSetAttributesFromRecords(LLVMValueRef /*Function|CallBase*/ functionOrCall, LibLLVMAttributeRecord const* records, size_t numRecords);
+
+    // Gets the total number of attributes for all indices of a function or call site. The value this
+    // returns is used to allocate an array of records for LibLLVMGetAttributeRecords()
+    size_t LibLLVMGetAttributeRecordCount(LLVMValueRef /*Function|CallBase*/ functionOrCall);
+
+    // Fills in an array of records for all the attributes of a function or call site. String members of
+    // the records refer to the uniqued attribute storage of the context and are not disposed. The
+    // AttributeRef member is always set for every record.
+    LLVMErrorRef LibLLVMGetAttributeRecords(LLVMValueRef /*Function|CallBase*/ functionOrCall, /*(OUT, LibLLVMAttributeRecord[numRecords])*/ LibLLVMAttributeRecord* records, size_t numRecords);
+
     // NOTE: String attributes will have a name of "none" as the ID is 0
     // NOTE: Out of range IDs will have an empty string (ret: nullptr, *len: 0)
     char const* LibLLVMGetAttributeNameFromID(uint32_t id, /*[Out]*/ uint32_t* len);
@@ -1,11 +1,100 @@
 #ifndef _CONTEXT_BINDINGS_H_
 #define _CONTEXT_BINDINGS_H_
 
+#include <stdint.h>
 #include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+#include "llvm-c/Orc.h"
 
 LLVM_C_EXTERN_C_BEGIN
     LLVMBool LibLLVMContextGetIsODRUniquingDebugTypes( LLVMContextRef context );
     void LibLLVMContextSetIsODRUniquingDebugTypes( LLVMContextRef context, LLVMBool state );
+
+    // A pool of contexts that are leased to a worker thread for the duration of some IR
+    // generation and then returned for re-use. An LLVMContext is NOT thread safe, but
+    // distinct contexts are fully independent so that each worker holding its own lease
+    // can generate IR in parallel without any locking.
+    typedef struct LibLLVMOpaqueContextPool* LibLLVMContextPoolRef;
+
+    // Creates a new pool
+    //  preWarmCount:       Number of contexts created up front so the first leases don't pay for creation
+    //  maxRetained:        Maximum number of idle contexts kept for re-use; 0 means no limit
+    //  maxLeasesPerContext: Maximum number of times a context is leased; A returned context that reached this
+    //                      is destroyed instead of recycled. As the uniqued state of a context only grows,
+    //                      this bounds the memory a recycled context retains. 0 means no limit.
+    // Pool is disposed with LibLLVMDisposeContextPool(), which destroys the idle contexts and the
+    // contexts of any raw leases (LibLLVMContextPoolLease()) still outstanding. A context leased as a
+    // ThreadSafeContext is kept alive by the caller's handle, but that handle can no longer be returned
+    // to the pool. Thus, ALL leases must be released BEFORE the pool is disposed.
+    LibLLVMContextPoolRef LibLLVMCreateContextPool( uint32_t preWarmCount, uint32_t maxRetained, uint32_t maxLeasesPerContext );
+    void LibLLVMDisposeContextPool( LibLLVMContextPoolRef pool );
+
+    // Leases a context from the pool, creating one if no idle context is available
+    // The returned context is owned by the pool and MUST NOT be disposed with LLVMContextDispose()
+    // instead it is returned to the pool with LibLLVMContextPoolRelease(). Any modules created in the
+    // context should be disposed before release, a context that still owns modules is destroyed
+    // along with the modules instead of being recycled.
+    LLVMContextRef LibLLVMContextPoolLease( LibLLVMContextPoolRef pool );
+    void LibLLVMContextPoolRelease( LibLLVMContextPoolRef pool, LLVMContextRef context );
+
+    // Leases a context from the pool wrapped as an ORC ThreadSafeContext for use with the ORC JIT
+    // The returned handle MUST NOT be disposed with LLVMOrcDisposeThreadSafeContext(), instead it is
+    // returned to the pool with LibLLVMContextPoolReleaseThreadSafe(). The caller is responsible to
+    // ensure that no ThreadSafeModule created from the context is still in use (e.g. pending
+    // materialization in a JIT) when it is released.
+    LLVMOrcThreadSafeContextRef LibLLVMContextPoolLeaseThreadSafe( LibLLVMContextPoolRef pool );
+    void LibLLVMContextPoolReleaseThreadSafe( LibLLVMContextPoolRef pool, LLVMOrcThreadSafeContextRef context );
+
+    // Diagnostic counts for the pool; These are a snapshot and are inherently racy when other
+    // threads are leasing or releasing contexts.
+    uint32_t LibLLVMContextPoolGetIdleCount( LibLLVMContextPoolRef pool );
+    uint32_t LibLLVMContextPoolGetLeasedCount( LibLLVMContextPoolRef pool );
+
+    // Count and ESTIMATED size (in bytes) of one category of uniqued items reachable from the modules of a
+    // context. The estimate is the sizeof the actual class of each object plus its co-allocated operands and
+    // inline data (i.e. the elements of a data constant or the characters of a string). It does NOT include
+    // allocator overhead or the hash tables used for uniquing. The implementation objects of attributes are
+    // private to LLVM so for them the estimate is only the data of string attributes and the arrays of
+    // attributes and sets held by the sets and lists; Enum, integer and type attributes contribute 0 bytes.
+    typedef struct LibLLVMReachableIRStats
+    {
+        uint64_t Count;
+        uint64_t EstimatedBytes;
+    } LibLLVMReachableIRStats;
+
+    typedef struct LibLLVMReachableIREstimate
+    {
+        LibLLVMReachableIRStats ScalarConstants;        // ConstantInt, ConstantFP, zero, null, undef, poison
+        LibLLVMReachableIRStats AggregateConstants;     // ConstantArray, ConstantStruct, ConstantVector
+        LibLLVMReachableIRStats DataConstants;          // ConstantDataArray, ConstantDataVector
+        LibLLVMReachableIRStats ExpressionConstants;    // ConstantExpr
+        LibLLVMReachableIRStats Types;
+        LibLLVMReachableIRStats UniquedMDNodes;
+        LibLLVMReachableIRStats DistinctMDNodes;
+        LibLLVMReachableIRStats MDStrings;
+        LibLLVMReachableIRStats Attributes;
+        LibLLVMReachableIRStats AttributeSets;
+        LibLLVMReachableIRStats AttributeLists;
+        uint32_t ModuleCount;                           // Number of modules that currently exist in the context
+    } LibLLVMReachableIREstimate;
+
+    // Fills in an estimate of the uniqued state of a context that is reachable from the modules in the
+    // context. This is NOT an accounting of the memory of the context; The uniquing tables of the context
+    // are private to LLVM, so state that no module refers to anymore (i.e. left behind by a disposed module)
+    // is NOT included and the sizes are estimates (see LibLLVMReachableIRStats). This walks all of the IR and
+    // metadata of the modules so the cost is proportional to the size of the modules. It is intended for
+    // diagnostics and relative comparisons (i.e. recycling decisions), NOT for use on every IR construction.
+    LLVMErrorRef LibLLVMContextEstimateReachableIR( LLVMContextRef context, /*[out, byref]*/ LibLLVMReachableIREstimate* pEstimate );
+
+    // Destroys uniqued aggregate and expression constants that have no uses, repeating until no more
+    // unused constants remain. Returns the number of constants destroyed. Only unused constants that
+    // refer (directly or through other constants) to a global value or to a constant used by a module
+    // in the context are found; others are not reachable without the private uniquing tables.
+    // NOTE: Any handle to an unused constant is invalidated by this call. Constants referenced by
+    // metadata (i.e. ConstantAsMetadata in debug info) or by a value handle are kept. Scalar constants
+    // are not trimmed as they are cheap and commonly re-created. Metadata is NEVER trimmed, as references
+    // to metadata are not tracked in a way that allows determining if it is unreferenced.
+    uint64_t LibLLVMContextTrimUnusedConstants( LLVMContextRef context );
 LLVM_C_EXTERN_C_END
 
 #endif
@@ -1,5 +1,6 @@
 #ifndef LLVM_DATALAYOUT_BINDINGS_H
 #define LLVM_DATALAYOUT_BINDINGS_H
+#include <stdint.h>
 #include <llvm-c/Types.h>
 #include <llvm-c/Error.h>
 #include <llvm-c/Target.h>
@@ -10,6 +11,66 @@ LLVM_C_EXTERN_C_BEGIN
     LLVMErrorRef LibLLVMParseDataLayout(char const* layoutString, size_t strLen, /*out*/ LLVMTargetDataRef* outRetVal);
     char const* LibLLVMGetDataLayoutString(LLVMTargetDataRef dataLayout, /*out*/ size_t* outLen);
     LLVMBool LibLLVMTargeDataRefOpEquals(LLVMTargetDataRef lhs, LLVMTargetDataRef rhs);
+
+    // Interned layouts
+    // An interned layout is a parsed layout specification held in a process wide, thread safe, table. Interning
+    // the same string, or any string that parses to an equal layout, always produces the same handle. Thus, the
+    // string is parsed only once and equality of two interned handles is simply identity. An interned handle
+    // lives for the lifetime of the process and MUST NOT be disposed with LLVMDisposeTargetData(); Calling
+    // LibLLVMDisposeDataLayout() on it is allowed but is a NOP. Parse errors are NOT cached, an invalid string
+    // returns an error on each call.
+    //
+    // A DataLayout caches the layout of each struct type it is asked about; that cache is NOT thread safe and
+    // is only valid while the context of the types lives. So the queries of this library (LibLLVMGetTypeLayouts()
+    // and LibLLVMGetStructLayout()) on an interned handle use a private copy of the layout and are safe from any
+    // thread. The LLVM-C queries (i.e. LLVMABISizeOfType() or LLVMOffsetOfElement()) use the shared layout
+    // directly and MUST NOT be used with struct types on an interned handle.
+    LLVMErrorRef LibLLVMInternDataLayout(char const* layoutString, size_t strLen, /*out*/ LLVMTargetDataRef* outRetVal);
+    LLVMBool LibLLVMDataLayoutIsInterned(LLVMTargetDataRef dataLayout);
+
+    // Disposes a layout that is NOT interned; A NOP for an interned layout so this is safe for any handle
+    void LibLLVMDisposeDataLayout(LLVMTargetDataRef dataLayout);
+
+    // Gets a 64 bit hash of a layout; Layouts that are equal (see: LibLLVMTargeDataRefOpEquals()) always
+    // have the same hash, even when written as different strings. For an interned layout this is
+    // pre-computed when interned. For any other layout the hash is computed on each call from the sizes
+    // and alignments the layout produces for a fixed set of types and address spaces.
+    uint64_t LibLLVMDataLayoutGetHash(LLVMTargetDataRef dataLayout);
+
+    // Size and alignment of a type for a given layout
+    // For scalable types the sizes are the known minimum size (e.g. the size when vscale is 1)
+    //
+    // Queries of struct types fill a cache of the layout that is keyed by the type. For a layout that is NOT
+    // interned the cache is used directly, so such a handle is single threaded (queries MUST NOT run on more
+    // than one thread at a time) and MUST NOT be used for struct types of a context after any context whose
+    // struct types it has seen is destroyed, as the address of a destroyed type may be re-used. Interned
+    // layouts have neither restriction for these queries (see: LibLLVMInternDataLayout()).
+    typedef struct LibLLVMTypeLayout
+    {
+        uint64_t StoreSize;         // Bytes
+        uint64_t AllocSize;         // Bytes
+        uint64_t BitSize;
+        uint32_t AbiAlignment;      // Bytes
+        uint32_t PrefAlignment;     // Bytes
+        LLVMBool IsScalable;
+    } LibLLVMTypeLayout;
+
+    // Fills in the layout for each of an array of types; layouts is an array with at least numTypes elements.
+    // All types MUST be sized (see: LLVMTypeIsSized()), an error is returned for the first unsized type
+    LLVMErrorRef LibLLVMGetTypeLayouts( LLVMTargetDataRef dataLayout
+                                      , LLVMTypeRef const* types
+                                      , size_t numTypes
+                                      , /*(OUT, LibLLVMTypeLayout[numTypes])*/ LibLLVMTypeLayout* layouts
+                                      );
+
+    // Gets the layout of a struct along with the byte offsets of ALL members in one call.
+    // offsets is an array with at least LLVMCountStructElementTypes() elements.
+    LLVMErrorRef LibLLVMGetStructLayout( LLVMTargetDataRef dataLayout
+                                       , LLVMTypeRef structType
+                                       , /*[out, byref]*/ LibLLVMTypeLayout* pLayout
+                                       , /*(OUT, uint64_t[numOffsets])*/ uint64_t* offsets
+                                       , size_t numOffsets
+                                       );
 LLVM_C_EXTERN_C_END
 
 #endif
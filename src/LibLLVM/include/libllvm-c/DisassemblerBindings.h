@@ -0,0 +1,89 @@
+#ifndef _LIBLLVM_DISASSEMBLER_BINDINGS_H_
+#define _LIBLLVM_DISASSEMBLER_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // Disassembler that decodes an entire region of code in a single call. The target for the triple MUST
+    // have the disassembler registered (see: LibLLVMRegisterTarget() with TargetRegistration_Disassembler).
+    // A batch disassembler is immutable once created so it is safe to use from multiple threads at once.
+    typedef struct LibLLVMOpaqueBatchDisassembler* LibLLVMBatchDisassemblerRef;
+
+    // Creates a batch disassembler; none of the strings are required to be nul terminated and the
+    // cpu and features are optional (null or empty)
+    //  syntaxVariant: Target specific variant of the assembly syntax for formatted text (i.e. 1 is Intel syntax for X86)
+    LLVMErrorRef LibLLVMCreateBatchDisassembler( char const* triple
+                                               , size_t tripleLen
+                                               , char const* cpu
+                                               , size_t cpuLen
+                                               , char const* features
+                                               , size_t featuresLen
+                                               , uint32_t syntaxVariant
+                                               , /*[out]*/ LibLLVMBatchDisassemblerRef* outRetVal
+                                               );
+
+    void LibLLVMDisposeBatchDisassembler( LibLLVMBatchDisassemblerRef disassembler );
+
+    // Gets the name of a target opcode (i.e. "ADD32rr"); result is NOT nul terminated and is a
+    // constant string. Returns null for an invalid opcode.
+    char const* LibLLVMBatchDisassemblerGetOpcodeName( LibLLVMBatchDisassemblerRef disassembler, uint32_t opcode, /*[out]*/ size_t* len );
+
+    // The distinct mnemonics of all of the opcodes of the target are assigned an id when the disassembler
+    // is created; ids are in the range [0, LibLLVMBatchDisassemblerGetNumMnemonics())
+    uint32_t LibLLVMBatchDisassemblerGetNumMnemonics( LibLLVMBatchDisassemblerRef disassembler );
+
+    // Gets the mnemonic for an id (i.e. "add"); result is NOT nul terminated and is valid until the
+    // disassembler is disposed. Returns null for an invalid id.
+    char const* LibLLVMBatchDisassemblerGetMnemonic( LibLLVMBatchDisassemblerRef disassembler, uint32_t mnemonicId, /*[out]*/ size_t* len );
+
+    // This is a "FLAGS" enum
+    typedef enum LibLLVMDisassembleOptions
+    {
+        LibLLVMDisassembleOptions_None = 0,
+        LibLLVMDisassembleOptions_FormatText = 1 << 0,      // Format the text of each instruction into the packed text of the results
+        LibLLVMDisassembleOptions_HexImmediates = 1 << 1,   // Print immediate values as hex in the formatted text
+    } LibLLVMDisassembleOptions;
+
+    // Bytes that are not a valid encoding are a single record with an Opcode and MnemonicId of UINT32_MAX,
+    // and a Length of the minimum instruction alignment of the target; decoding continues after them.
+    typedef struct LibLLVMDisassembledInstruction
+    {
+        uint64_t Offset;            // Offset of the instruction from the start of the region
+        uint32_t Length;            // Length of the encoding in bytes
+        uint32_t Opcode;            // Target specific opcode (see: LibLLVMBatchDisassemblerGetOpcodeName())
+        uint32_t MnemonicId;        // see: LibLLVMBatchDisassemblerGetMnemonic()
+        uint32_t TextLength;        // 0 if text is not formatted
+        uint64_t TextOffset;        // Offset of the formatted text in the packed text of the results
+    } LibLLVMDisassembledInstruction;
+
+    typedef struct LibLLVMOpaqueDisassembleResults* LibLLVMDisassembleResultsRef;
+
+    // Decodes all of the instructions of a region of code.
+    //  address:            Runtime address of the first byte of the region, used for PC relative operands in the text
+    //  functionOffsets:    Optional sorted array of the offsets of the start of each function in the region.
+    //                      Decoding is only split across threads at these offsets, as decoding from an arbitrary
+    //                      offset is not reliable for targets with variable length instructions. Without them the
+    //                      region is decoded on the calling thread.
+    // The results MUST be disposed with LibLLVMDisposeDisassembleResults()
+    LLVMErrorRef LibLLVMBatchDisassemble( LibLLVMBatchDisassemblerRef disassembler
+                                        , uint8_t const* bytes
+                                        , uint64_t numBytes
+                                        , uint64_t address
+                                        , uint64_t const* functionOffsets
+                                        , size_t numFunctionOffsets
+                                        , LibLLVMDisassembleOptions options
+                                        , /*[out]*/ LibLLVMDisassembleResultsRef* outResults
+                                        );
+
+    void LibLLVMDisposeDisassembleResults( LibLLVMDisassembleResultsRef results );
+
+    // Gets the instructions of the region in the order of their offsets
+    LibLLVMDisassembledInstruction const* LibLLVMDisassembleResultsGetInstructions( LibLLVMDisassembleResultsRef results, /*[out]*/ size_t* numInstructions );
+
+    // Gets the packed text of all instructions; NOT nul terminated and empty if the text is not formatted
+    char const* LibLLVMDisassembleResultsGetText( LibLLVMDisassembleResultsRef results, /*[out]*/ size_t* len );
+LLVM_C_EXTERN_C_END
+
+#endif
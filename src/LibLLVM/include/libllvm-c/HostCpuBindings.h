@@ -0,0 +1,82 @@
+#ifndef _LIBLLVM_HOSTCPU_BINDINGS_H_
+#define _LIBLLVM_HOSTCPU_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+#include "llvm-c/TargetMachine.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // CPU and features of the host, detected once per process. The features are kept as a bitset indexed by the
+    // subtarget feature table of the native target (including all features implied by the enabled ones) so that
+    // queries are a bit test instead of parsing a feature string. The result is owned by the library, valid for
+    // the life of the process, immutable and safe to use from multiple threads at once. It is NOT disposed.
+    typedef struct LibLLVMOpaqueHostCpu* LibLLVMHostCpuRef;
+
+    // Gets the host CPU information, detecting it on the first successful call. The native target MUST be
+    // registered (see: LibLLVMRegisterTarget() with CodeGenTarget_Native); if it is not the result is an error
+    // and detection is attempted again on the next call.
+    LLVMErrorRef LibLLVMGetHostCpu( /*[out]*/ LibLLVMHostCpuRef* outRetVal );
+
+    // The strings are nul terminated constants; len is the length without the terminator
+    char const* LibLLVMHostCpuGetTriple( LibLLVMHostCpuRef host, /*[out]*/ size_t* len );
+    char const* LibLLVMHostCpuGetName( LibLLVMHostCpuRef host, /*[out]*/ size_t* len );
+
+    // Gets the features of the host in canonical form; the detected features that the native target knows, sorted
+    // by name as "+name" or "-name" separated by commas. Identical hosts produce identical strings.
+    char const* LibLLVMHostCpuGetFeatures( LibLLVMHostCpuRef host, /*[out]*/ size_t* len );
+
+    // Gets the number of features in the subtarget feature table of the native target; valid feature indices
+    // are in the range [0, LibLLVMHostCpuGetNumFeatures())
+    uint32_t LibLLVMHostCpuGetNumFeatures( LibLLVMHostCpuRef host );
+
+    // Gets the name of the feature at an index of the feature table; Returns null for an invalid index
+    char const* LibLLVMHostCpuGetFeatureName( LibLLVMHostCpuRef host, uint32_t index, /*[out]*/ size_t* len );
+
+    // Gets the index of a feature of the feature table by name (i.e. "avx2"); the name is NOT required to be nul
+    // terminated. Returns UINT32_MAX if the target has no feature with the name.
+    uint32_t LibLLVMHostCpuFindFeature( LibLLVMHostCpuRef host, char const* name, size_t nameLen );
+
+    // Tests if the host has a feature by index (see: LibLLVMHostCpuFindFeature()); false for an invalid index
+    LLVMBool LibLLVMHostCpuHasFeature( LibLLVMHostCpuRef host, uint32_t index );
+
+    // Gets the number of 64 bit words of the bitset of enabled features
+    uint32_t LibLLVMHostCpuGetNumFeatureWords( LibLLVMHostCpuRef host );
+
+    // Gets the bitset of all enabled features; bit N (bit N % 64 of word N / 64) is feature index N. words is an
+    // array with at least LibLLVMHostCpuGetNumFeatureWords() elements.
+    LLVMErrorRef LibLLVMHostCpuGetFeatureBits( LibLLVMHostCpuRef host
+                                             , /*(OUT, uint64_t[numWords])*/ uint64_t* words
+                                             , uint32_t numWords
+                                             );
+
+    // Canonical options for a TargetMachine that generates code for the host (i.e. for JIT execution). Options
+    // that are equal describe equivalent target machines so they are suitable as the key of a cache or pool of
+    // target machines. The strings are the nul terminated constants of the host CPU information.
+    typedef struct LibLLVMNativeTargetMachineOptions
+    {
+        char const* Triple;
+        size_t TripleLen;
+        char const* CPU;
+        size_t CPULen;
+        char const* Features;
+        size_t FeaturesLen;
+        LLVMCodeGenOptLevel OptLevel;
+        LLVMRelocMode RelocMode;
+        LLVMCodeModel CodeModel;
+    } LibLLVMNativeTargetMachineOptions;
+
+    // Gets the canonical native options for an optimization level; The relocation model is the default and the
+    // code model is the default for JIT.
+    void LibLLVMHostCpuGetNativeTargetMachineOptions( LibLLVMHostCpuRef host
+                                                    , LLVMCodeGenOptLevel optLevel
+                                                    , /*[out]*/ LibLLVMNativeTargetMachineOptions* options
+                                                    );
+
+    // Creates options for LLVMCreateTargetMachineWithOptions() from the canonical native options (the Triple is
+    // an argument of that function and is not part of the result); The result MUST be disposed with
+    // LLVMDisposeTargetMachineOptions(). Returns null if options is null.
+    LLVMTargetMachineOptionsRef LibLLVMCreateNativeTargetMachineOptions( LibLLVMNativeTargetMachineOptions const* options );
+LLVM_C_EXTERN_C_END
+
+#endif
@@ -1,12 +1,168 @@
 #ifndef _LIBLLVM_OBJECTILE_BINDINGS_H_
 #define _LIBLLVM_OBJECTILE_BINDINGS_H_
 
+#include <stdint.h>
+#include "llvm-c/Error.h"
 #include "llvm-c/Object.h"
 
 LLVM_C_EXTERN_C_BEGIN
     LLVMSymbolIteratorRef LibLLVMSymbolIteratorClone( LLVMSymbolIteratorRef ref );
     LLVMSectionIteratorRef LibLLVMSectionIteratorClone( LLVMSectionIteratorRef ref );
     LLVMRelocationIteratorRef LibLLVMRelocationIteratorClone( LLVMRelocationIteratorRef ref );
+
+    // An object file opened directly over a memory mapped file; The contents of the file are NOT copied
+    // so opening even a very large file is cheap and only the pages actually used are read. All strings
+    // returned for the object (i.e. symbol names) point into the mapped file and are valid until the
+    // object is disposed with LibLLVMDisposeMappedObjectFile().
+    typedef struct LibLLVMOpaqueMappedObjectFile* LibLLVMMappedObjectFileRef;
+
+    // The path is NOT required to be nul terminated
+    LLVMErrorRef LibLLVMOpenMappedObjectFile( char const* path, size_t pathLen, /*[out]*/ LibLLVMMappedObjectFileRef* outRetVal );
+    void LibLLVMDisposeMappedObjectFile( LibLLVMMappedObjectFileRef objFile );
+
+    // Gets the object file as a binary for use with the LLVM-C object APIs (i.e. LLVMObjectFileCopySectionIterator())
+    // The result is an alias owned by the mapped object file and MUST NOT be disposed with LLVMDisposeBinary()
+    LLVMBinaryRef LibLLVMMappedObjectFileGetBinary( LibLLVMMappedObjectFileRef objFile );
+
+    // Values match llvm::object::BasicSymbolRef::Flags
+    typedef enum LibLLVMObjectSymbolFlags
+    {
+        LibLLVMObjectSymbolFlags_None = 0,
+        LibLLVMObjectSymbolFlags_Undefined = 1 << 0,
+        LibLLVMObjectSymbolFlags_Global = 1 << 1,
+        LibLLVMObjectSymbolFlags_Weak = 1 << 2,
+        LibLLVMObjectSymbolFlags_Absolute = 1 << 3,
+        LibLLVMObjectSymbolFlags_Common = 1 << 4,
+        LibLLVMObjectSymbolFlags_Indirect = 1 << 5,
+        LibLLVMObjectSymbolFlags_Exported = 1 << 6,
+        LibLLVMObjectSymbolFlags_FormatSpecific = 1 << 7,
+        LibLLVMObjectSymbolFlags_Thumb = 1 << 8,
+        LibLLVMObjectSymbolFlags_Hidden = 1 << 9,
+        LibLLVMObjectSymbolFlags_Const = 1 << 10,
+        LibLLVMObjectSymbolFlags_Executable = 1 << 11,
+    } LibLLVMObjectSymbolFlags;
+
+    // Values match llvm::object::SymbolRef::Type
+    typedef enum LibLLVMObjectSymbolType
+    {
+        LibLLVMObjectSymbolType_Unknown,
+        LibLLVMObjectSymbolType_Data,
+        LibLLVMObjectSymbolType_Debug,
+        LibLLVMObjectSymbolType_File,
+        LibLLVMObjectSymbolType_Function,
+        LibLLVMObjectSymbolType_Other,
+    } LibLLVMObjectSymbolType;
+
+    typedef struct LibLLVMObjectSymbol
+    {
+        char const* Name;           // Points into the string table of the mapped file, NOT nul terminated
+        size_t NameLen;
+        uint64_t Address;
+        uint64_t Size;              // 0 if not known for the format and symbol
+        uint32_t SectionIndex;      // UINT32_MAX if not in a section (i.e. undefined or absolute symbols)
+        uint32_t Flags;             // LibLLVMObjectSymbolFlags
+        LibLLVMObjectSymbolType Type;
+    } LibLLVMObjectSymbol;
+
+    // Gets the number of symbols in the symbol table of the object; if dynamic is true then the dynamic symbol
+    // table is used, which is only available for ELF files. (0 for other formats)
+    uint64_t LibLLVMMappedObjectFileGetNumSymbols( LibLLVMMappedObjectFileRef objFile, LLVMBool dynamic );
+
+    // Fills in an array of all of the symbols of a symbol table in a single call. symbols is an array with at least
+    // LibLLVMMappedObjectFileGetNumSymbols() elements. For formats other than ELF the size of each symbol is computed
+    // from the addresses of the symbols in the same section, which requires a sort of all symbols.
+    LLVMErrorRef LibLLVMMappedObjectFileGetSymbols( LibLLVMMappedObjectFileRef objFile
+                                                  , LLVMBool dynamic
+                                                  , /*(OUT, LibLLVMObjectSymbol[numSymbols])*/ LibLLVMObjectSymbol* symbols
+                                                  , uint64_t numSymbols
+                                                  );
+
+    // Gets the number of sections of the object; Section indices in the other APIs are in the range [0, count)
+    uint32_t LibLLVMMappedObjectFileGetNumSections( LibLLVMMappedObjectFileRef objFile );
+
+    typedef struct LibLLVMObjectRelocation
+    {
+        uint64_t Offset;
+        uint64_t Type;              // Format and target specific type of the relocation
+        int64_t Addend;             // Explicit addend (ELF RELA only); 0 for all other relocations
+        uint32_t SymbolIndex;       // Index into the symbol table (see: LibLLVMMappedObjectFileGetSymbols()) or UINT32_MAX if none
+        LLVMBool SymbolIsDynamic;   // SymbolIndex is for the ELF dynamic symbol table
+    } LibLLVMObjectRelocation;
+
+    // Fills in the number of relocations of each section; counts is an array with at least
+    // LibLLVMMappedObjectFileGetNumSections() elements.
+    LLVMErrorRef LibLLVMMappedObjectFileGetRelocationCounts( LibLLVMMappedObjectFileRef objFile
+                                                           , /*(OUT, uint64_t[numSections])*/ uint64_t* counts
+                                                           , uint32_t numSections
+                                                           );
+
+    // Scans the relocations of all sections in parallel (one task per section) into a caller allocated arena.
+    // counts is the array filled in by LibLLVMMappedObjectFileGetRelocationCounts() and the arena is an array
+    // with at least the sum of all the counts elements. The relocations of each section are stored contiguously
+    // in the order of the sections; thus, the relocations for section N start at the sum of the counts of all
+    // sections before it. If any section fails the result is an error (the errors of all sections are joined)
+    // and the contents of the arena are undefined.
+    LLVMErrorRef LibLLVMMappedObjectFileScanRelocations( LibLLVMMappedObjectFileRef objFile
+                                                       , uint64_t const* counts
+                                                       , uint32_t numSections
+                                                       , /*(OUT, LibLLVMObjectRelocation[arenaLength])*/ LibLLVMObjectRelocation* arena
+                                                       , uint64_t arenaLength
+                                                       );
+
+    // An archive (static library) opened directly over a memory mapped file. The symbol index of the archive
+    // is read once when it is opened so finding the member that defines a symbol is a single hash lookup. The
+    // members are parsed into object files only when they are requested, or all at once (in parallel) with
+    // LibLLVMMappedArchiveParseAllMembers(). Member objects are owned by the archive.
+    typedef struct LibLLVMOpaqueMappedArchive* LibLLVMMappedArchiveRef;
+
+    // Kind of the content of a member of an archive. Only object files are parsed; the other kinds are skipped
+    // by LibLLVMMappedArchiveParseAllMembers() as a linker would.
+    typedef enum LibLLVMArchiveMemberKind
+    {
+        LibLLVMArchiveMemberKind_NotOpened,     // Not opened yet or not a valid binary
+        LibLLVMArchiveMemberKind_Object,
+        LibLLVMArchiveMemberKind_Bitcode,
+        LibLLVMArchiveMemberKind_ShortImport,   // Short import member of a COFF import library
+        LibLLVMArchiveMemberKind_Other,         // Any other binary that is not an object file (i.e. a nested archive)
+    } LibLLVMArchiveMemberKind;
+
+    // The path is NOT required to be nul terminated
+    LLVMErrorRef LibLLVMOpenMappedArchive( char const* path, size_t pathLen, /*[out]*/ LibLLVMMappedArchiveRef* outRetVal );
+    void LibLLVMDisposeMappedArchive( LibLLVMMappedArchiveRef archive );
+
+    uint32_t LibLLVMMappedArchiveGetNumMembers( LibLLVMMappedArchiveRef archive );
+
+    // Gets the name of a member; the result is NOT nul terminated and is valid until the archive is disposed
+    char const* LibLLVMMappedArchiveGetMemberName( LibLLVMMappedArchiveRef archive, uint32_t index, /*[out]*/ size_t* len );
+
+    // Gets the number of distinct symbols in the symbol index of the archive (0 if the archive has no index)
+    uint64_t LibLLVMMappedArchiveGetNumSymbols( LibLLVMMappedArchiveRef archive );
+
+    // Gets the index of the member that defines a symbol or UINT32_MAX if the symbol index does not contain it.
+    // If more than one member defines the symbol the first one is used, as a linker does.
+    uint32_t LibLLVMMappedArchiveFindSymbolMember( LibLLVMMappedArchiveRef archive, char const* name, size_t nameLen );
+
+    // Gets the object file of a member, parsing it on first use. The result is owned by the archive and MUST NOT
+    // be disposed with LibLLVMDisposeMappedObjectFile(); It is valid until the archive is disposed. Members that
+    // are not object files (i.e. bitcode or short import members) are an error, the kind of a member is available
+    // from LibLLVMMappedArchiveGetMemberKind().
+    LLVMErrorRef LibLLVMMappedArchiveGetMemberObject( LibLLVMMappedArchiveRef archive
+                                                    , uint32_t index
+                                                    , /*[out]*/ LibLLVMMappedObjectFileRef* outRetVal
+                                                    );
+
+    // Gets the kind of a member, opening it on first use as LibLLVMMappedArchiveGetMemberObject() does. The result
+    // is LibLLVMArchiveMemberKind_NotOpened if the index is out of range or the member is not a valid binary (the
+    // error is available from LibLLVMMappedArchiveGetMemberObject()).
+    LibLLVMArchiveMemberKind LibLLVMMappedArchiveGetMemberKind( LibLLVMMappedArchiveRef archive, uint32_t index );
+
+    // Opens all members that are not already opened in parallel (one task per member). Members that are not object
+    // files (i.e. the short import members of a Windows import library or bitcode) are NOT an error; they are only
+    // classified (see: LibLLVMMappedArchiveGetMemberKind()) and are not opened again. If any member fails the result
+    // is an error (the errors of all members are joined); the members that succeeded remain opened. The data of the
+    // members is located serially before the parallel parse as, for a thin archive, that opens the member files and
+    // records them in the archive; so for a thin archive all member files are opened first.
+    LLVMErrorRef LibLLVMMappedArchiveParseAllMembers( LibLLVMMappedArchiveRef archive );
 LLVM_C_EXTERN_C_END
 
 #endif
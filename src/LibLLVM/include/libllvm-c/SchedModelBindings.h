@@ -0,0 +1,81 @@
+#ifndef _LIBLLVM_SCHEDMODEL_BINDINGS_H_
+#define _LIBLLVM_SCHEDMODEL_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // Scheduling model (MCSchedModel) of a CPU exported as flat tables. The tables are built on the first request
+    // for a triple and CPU and are cached for the life of the process, so the result is owned by the library and
+    // is NOT disposed. All of the tables are immutable so they are safe to use from multiple threads at once.
+    typedef struct LibLLVMOpaqueSchedModel* LibLLVMSchedModelRef;
+
+    // Gets the scheduling model of a CPU; neither string is required to be nul terminated. The target for the
+    // triple MUST have the TargetMachine registered and the cpu MUST have a scheduling model
+    // (i.e. "skylake" or "znver3"; the generic CPU of many targets does not have one).
+    LLVMErrorRef LibLLVMGetSchedModel( char const* triple
+                                     , size_t tripleLen
+                                     , char const* cpu
+                                     , size_t cpuLen
+                                     , /*[out]*/ LibLLVMSchedModelRef* outRetVal
+                                     );
+
+    typedef struct LibLLVMSchedModelInfo
+    {
+        uint32_t IssueWidth;
+        uint32_t MicroOpBufferSize;             // 0 for an in-order CPU
+        uint32_t LoopMicroOpBufferSize;
+        uint32_t LoadLatency;
+        uint32_t HighLatency;
+        uint32_t MispredictPenalty;
+        LLVMBool IsOutOfOrder;
+        LLVMBool CompleteModel;                 // The model describes all instructions
+        uint32_t NumProcResources;
+        uint32_t NumOpcodes;
+        uint64_t NumResourceUsages;
+    } LibLLVMSchedModelInfo;
+
+    void LibLLVMSchedModelGetInfo( LibLLVMSchedModelRef model, /*[out]*/ LibLLVMSchedModelInfo* info );
+
+    // Processor resource (i.e. an execution port or a group of them); Index 0 is the invalid resource
+    typedef struct LibLLVMProcResource
+    {
+        char const* Name;                       // Constant string; NOT nul terminated
+        size_t NameLen;
+        uint32_t NumUnits;
+        int32_t BufferSize;                     // -1 uses the unified buffer of the CPU; 0 is in-order; Otherwise the size of its own buffer
+        uint32_t SuperIndex;                    // Index of the resource this is a unit of; 0 if none
+        uint32_t NumSubUnits;                   // Number of resources in a group; 0 if the resource is not a group
+    } LibLLVMProcResource;
+
+    // Use of a processor resource by an instruction, in cycles relative to the issue of the instruction
+    typedef struct LibLLVMResourceUsage
+    {
+        uint32_t ResourceIndex;
+        uint32_t AcquireAtCycle;
+        uint32_t ReleaseAtCycle;
+    } LibLLVMResourceUsage;
+
+    // Scheduling information of an opcode of the target. Opcodes that have a variant scheduling class are resolved
+    // by the operands of the actual instruction so only IsVariant is set for them.
+    typedef struct LibLLVMOpcodeSchedInfo
+    {
+        char const* Name;                       // Name of the opcode (i.e. "ADD32rr"); Constant string NOT nul terminated
+        size_t NameLen;
+        int32_t Latency;                        // Latency of the output with the longest latency
+        uint32_t NumMicroOps;
+        double ReciprocalThroughput;            // 0 if not known
+        uint64_t FirstResourceUsage;            // Start of the resources used in the resource usage table
+        uint32_t NumResourceUsages;
+        LLVMBool IsValid;                       // The opcode has scheduling information in this model
+        LLVMBool IsVariant;
+    } LibLLVMOpcodeSchedInfo;
+
+    // Each of these gets a table of the model; The result is valid for the life of the process
+    LibLLVMProcResource const* LibLLVMSchedModelGetProcResources( LibLLVMSchedModelRef model, /*[out]*/ size_t* numResources );
+    LibLLVMOpcodeSchedInfo const* LibLLVMSchedModelGetOpcodes( LibLLVMSchedModelRef model, /*[out]*/ size_t* numOpcodes );
+    LibLLVMResourceUsage const* LibLLVMSchedModelGetResourceUsages( LibLLVMSchedModelRef model, /*[out]*/ size_t* numUsages );
+LLVM_C_EXTERN_C_END
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _STARTUP_PROFILE_BINDINGS_H_
+#define _STARTUP_PROFILE_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // Breakdown of the startup cost of this library. All times are in nanoseconds.
+    // The static initialization times are ONLY available when the library is built with
+    // startup profiling enabled (see: LibLLVMIsStartupProfileEnabled()) and are 0 otherwise.
+    typedef struct LibLLVMStartupProfile
+    {
+        uint64_t ProcessStartToLoadNs;      // Process creation to the start of static initialization of this library
+        uint64_t StaticInitNs;              // All static initializers of this library (LLVM cl::opt, pass and target tables, etc...)
+        uint64_t LoadToFirstQueryNs;        // End of static initialization to the first call to LibLLVMGetStartupProfile()
+        uint64_t TargetRegistrationNs;      // Total of all calls to LibLLVMRegisterTarget(), so far
+        uint32_t TargetRegistrationCount;   // Number of individual target pieces registered, so far
+        uint32_t RegisteredOptionCount;     // Number of LLVM command line options registered by static initialization
+    } LibLLVMStartupProfile;
+
+    LLVMBool LibLLVMIsStartupProfileEnabled();
+
+    // Fills in the startup profile; The target registration values reflect the registrations at the time
+    // of the call, so this is normally called after the application has registered all targets it uses.
+    // Per target registration details are available from LibLLVMGetTargetRegistrationInfos().
+    LLVMErrorRef LibLLVMGetStartupProfile( /*[out, byref]*/ LibLLVMStartupProfile* pProfile );
+LLVM_C_EXTERN_C_END
+
+#endif
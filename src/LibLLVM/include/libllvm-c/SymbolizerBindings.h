@@ -0,0 +1,85 @@
+#ifndef _LIBLLVM_SYMBOLIZER_BINDINGS_H_
+#define _LIBLLVM_SYMBOLIZER_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // Symbolizer that resolves addresses in binaries to source locations using the debug information
+    // (DWARF, PDB or the symbol table) of the binary. The parsed debug information for each binary is
+    // cached in the symbolizer and re-used across calls until the cache limit is reached or the cache
+    // is cleared. Each binary has a home shard (by path) of a fixed number of shards that resolve a batch
+    // in parallel. When a batch has many requests for one binary (at least 256 for each additional shard)
+    // they are split by address across consecutive shards so a single binary still uses all of them. Each
+    // shard that resolves requests of a binary parses and caches its own copy of the debug information, so
+    // the memory (and parse time) for such a binary is multiplied by the number of shards it is split across.
+    typedef struct LibLLVMOpaqueSymbolizer* LibLLVMSymbolizerRef;
+
+    // Creates a new symbolizer
+    //  demangle:       Demangle the names of functions
+    //  numShards:      Number of shards (max parallelism of a batch); 0 uses the number of hardware threads
+    //  maxCacheBytes:  Approximate limit of the cached debug information of each shard; 0 uses the LLVM default
+    LibLLVMSymbolizerRef LibLLVMCreateSymbolizer( LLVMBool demangle, uint32_t numShards, uint64_t maxCacheBytes );
+    void LibLLVMDisposeSymbolizer( LibLLVMSymbolizerRef symbolizer );
+
+    // Releases all cached binaries and debug information of the symbolizer. This is allowed while a batch is in
+    // progress on another thread; each shard is cleared once it finishes the requests of that batch.
+    void LibLLVMSymbolizerClearCache( LibLLVMSymbolizerRef symbolizer );
+
+    typedef struct LibLLVMSymbolizeRequest
+    {
+        char const* ModulePath;     // Path of the binary; NOT required to be nul terminated
+        size_t ModulePathLen;
+        uint64_t Address;           // Address in the binary (as in the symbol table), NOT a runtime address
+    } LibLLVMSymbolizeRequest;
+
+    // One frame of the source location of an address; String members are owned by the results
+    // and are NOT nul terminated. Unknown string values have a length of 0 and unknown line or
+    // column values are 0.
+    typedef struct LibLLVMSymbolizedFrame
+    {
+        char const* FunctionName;
+        size_t FunctionNameLen;
+        char const* FileName;
+        size_t FileNameLen;
+        uint32_t Line;
+        uint32_t Column;
+        uint32_t StartLine;         // Line of the start of the function
+        uint32_t Discriminator;
+    } LibLLVMSymbolizedFrame;
+
+    // Result for a single request; The frames for the request are [FirstFrame, FirstFrame + NumFrames)
+    // of the frames of the results. The first frame is the innermost (inlined) function and the last
+    // frame is the function containing the address in the binary. If the request failed (i.e. the binary
+    // could not be read) NumFrames is 0 and Error is a message describing the failure.
+    typedef struct LibLLVMSymbolizedAddress
+    {
+        uint64_t FirstFrame;
+        uint32_t NumFrames;
+        char const* Error;          // nullptr if no error; NOT nul terminated
+        size_t ErrorLen;
+    } LibLLVMSymbolizedAddress;
+
+    typedef struct LibLLVMOpaqueSymbolizeResults* LibLLVMSymbolizeResultsRef;
+
+    // Symbolizes a batch of addresses; Failure to resolve an individual address is reported in the results
+    // for that address and NOT as an error of the batch. The results MUST be disposed with
+    // LibLLVMDisposeSymbolizeResults(). Batches on multiple threads with the same symbolizer are allowed;
+    // each shard resolves the requests of one batch at a time.
+    LLVMErrorRef LibLLVMSymbolizeBatch( LibLLVMSymbolizerRef symbolizer
+                                      , LibLLVMSymbolizeRequest const* requests
+                                      , size_t numRequests
+                                      , /*[out]*/ LibLLVMSymbolizeResultsRef* outResults
+                                      );
+
+    void LibLLVMDisposeSymbolizeResults( LibLLVMSymbolizeResultsRef results );
+
+    // Gets the array of results, one for each request of the batch, in the same order as the requests
+    LibLLVMSymbolizedAddress const* LibLLVMSymbolizeResultsGetAddresses( LibLLVMSymbolizeResultsRef results, /*[out]*/ size_t* numAddresses );
+
+    // Gets the array of all frames of all requests of the batch
+    LibLLVMSymbolizedFrame const* LibLLVMSymbolizeResultsGetFrames( LibLLVMSymbolizeResultsRef results, /*[out]*/ size_t* numFrames );
+LLVM_C_EXTERN_C_END
+
+#endif
@@ -52,7 +52,50 @@ LLVM_C_EXTERN_C_BEGIN
     };
 
     // NOTE: registrations is not value checked. ONLY valid bits are tested and additional bits are ignored (NOP)
+    // Registration is thread safe and each kind is registered only once per target; repeated calls for
+    // kinds that are already registered are a NOP that does not take any locks.
     LLVMErrorRef LibLLVMRegisterTarget(LibLLVMCodeGenTarget target, LibLLVMTargetRegistrationKind registrations);
+
+    // Gets the kinds of registration supported by this build of the library. A reduced footprint build may
+    // exclude the AsmParser and/or Disassembler. Requests to register an excluded kind are ignored (NOP).
+    LibLLVMTargetRegistrationKind LibLLVMGetAvailableTargetRegistrations();
+
+    // Lazy registration (default is disabled)
+    // When enabled, requests to register the Disassembler or AsmParser are recorded as pending instead of
+    // registered. Pending registrations are completed on first use by a call to
+    // LibLLVMRegisterPendingTargetForTriple() with the triple that is about to be used. Kinds that were
+    // never requested are NOT registered by that call. The APIs of this library that need these kinds (the
+    // batch disassembler, assembler and throughput analyzer) make that call themselves; Users of the LLVM-C
+    // APIs that need them (i.e. LLVMCreateDisasm() or code generation of a module with inline assembly) MUST
+    // call it first. The AsmPrinter is always registered immediately as all code generation needs it.
+    //
+    // Registering a kind for CodeGenTarget_Native also registers it for the target of the native architecture
+    // and vice versa.
+    void LibLLVMSetLazyTargetRegistration(LLVMBool enable);
+    LLVMBool LibLLVMGetLazyTargetRegistration();
+    LLVMErrorRef LibLLVMRegisterPendingTargetForTriple(char const* triple, size_t tripleLen, LibLLVMTargetRegistrationKind registrations);
+
+    // Registration state of a single target. Times are in nanoseconds and are 0 for any
+    // kind that is not registered. For the native target the Target, TargetInfo and
+    // TargetMachine are registered together so the time for all three is in TargetNs.
+    typedef struct LibLLVMTargetRegistrationInfo
+    {
+        LibLLVMCodeGenTarget Target;
+        LibLLVMTargetRegistrationKind Registered;
+        LibLLVMTargetRegistrationKind Pending;
+        uint64_t TargetNs;
+        uint64_t TargetInfoNs;
+        uint64_t TargetMachineNs;
+        uint64_t AsmPrinterNs;
+        uint64_t DisassemblerNs;
+        uint64_t AsmParserNs;
+    } LibLLVMTargetRegistrationInfo;
+
+    // Gets the registration state of the native target followed by each of the runtime targets
+    // (see: LibLLVMGetRuntimeTargets()). The array must have at least LibLLVMGetNumTargetRegistrationInfos()
+    // elements.
+    int32_t LibLLVMGetNumTargetRegistrationInfos();
+    LLVMErrorRef LibLLVMGetTargetRegistrationInfos(LibLLVMTargetRegistrationInfo* infoArray, int32_t lengthOfArray);
     int32_t LibLLVMGetNumTargets();
     LLVMErrorRef LibLLVMGetRuntimeTargets(LibLLVMCodeGenTarget* targetArray, int32_t lengthOfArray);
 
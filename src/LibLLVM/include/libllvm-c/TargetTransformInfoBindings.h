@@ -0,0 +1,83 @@
+#ifndef _LIBLLVM_TARGETTRANSFORMINFO_BINDINGS_H_
+#define _LIBLLVM_TARGETTRANSFORMINFO_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+#include "llvm-c/TargetMachine.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // Cost model of a target (TargetTransformInfo) for a function; The answers depend on the target machine and the
+    // attributes of the function (i.e. "target-cpu" and "target-features") so a front end can query the cost model
+    // for the function it is about to generate. The function may be a declaration. The target machine and the
+    // function MUST remain valid until the TargetTransformInfo is disposed.
+    typedef struct LibLLVMOpaqueTargetTransformInfo* LibLLVMTargetTransformInfoRef;
+
+    LLVMErrorRef LibLLVMCreateTargetTransformInfo( LLVMTargetMachineRef tm, LLVMValueRef function, /*[out]*/ LibLLVMTargetTransformInfoRef* outRetVal );
+    void LibLLVMDisposeTargetTransformInfo( LibLLVMTargetTransformInfoRef tti );
+
+    typedef struct LibLLVMTargetTransformProperties
+    {
+        uint64_t ScalarRegisterBitWidth;
+        uint64_t FixedVectorRegisterBitWidth;
+        uint64_t ScalableVectorRegisterBitWidth;    // Minimum (known) width of a scalable vector register; 0 if not supported
+        uint32_t MinVectorRegisterBitWidth;
+        uint32_t NumScalarRegisters;
+        uint32_t NumVectorRegisters;
+        uint32_t CacheLineSize;                     // 0 if not known
+        uint32_t L1DataCacheSize;                   // 0 if not known
+        uint32_t L2DataCacheSize;                   // 0 if not known
+        uint32_t PrefetchDistance;                  // 0 if software prefetching is not profitable
+        uint32_t MaxScalarInterleaveFactor;         // Max interleave factor for a loop that is not vectorized
+        LLVMBool SupportsScalableVectors;
+    } LibLLVMTargetTransformProperties;
+
+    void LibLLVMTargetTransformInfoGetProperties( LibLLVMTargetTransformInfoRef tti, /*[out]*/ LibLLVMTargetTransformProperties* properties );
+
+    // Gets the max interleave factor (unroll factor for the interleaving of independent iterations) for a loop
+    // vectorized with a vectorization factor; scalable indicates the factor is a multiple of the scalable vector length
+    uint32_t LibLLVMTargetTransformInfoGetMaxInterleaveFactor( LibLLVMTargetTransformInfoRef tti, uint32_t vectorizationFactor, LLVMBool scalable );
+
+    // Values match llvm::TargetTransformInfo::TargetCostKind
+    typedef enum LibLLVMTargetCostKind
+    {
+        LibLLVMTargetCostKind_RecipThroughput,
+        LibLLVMTargetCostKind_Latency,
+        LibLLVMTargetCostKind_CodeSize,
+        LibLLVMTargetCostKind_SizeAndLatency,
+    } LibLLVMTargetCostKind;
+
+    typedef enum LibLLVMCostQueryKind
+    {
+        LibLLVMCostQueryKind_Arithmetic,    // Opcode is a unary or binary operator; Type is the type of the operation
+        LibLLVMCostQueryKind_Memory,        // Opcode is LLVMLoad or LLVMStore; Type is the type of the value loaded or stored
+        LibLLVMCostQueryKind_Cast,          // Opcode is a cast; Type is the destination type and SrcType is the source type
+    } LibLLVMCostQueryKind;
+
+    typedef struct LibLLVMCostQuery
+    {
+        LibLLVMCostQueryKind Kind;
+        LLVMOpcode Opcode;
+        LLVMTypeRef Type;
+        LLVMTypeRef SrcType;        // Cast only
+        uint32_t Alignment;         // Memory only; 0 uses the ABI alignment of the type, otherwise MUST be a power of two
+        uint32_t AddressSpace;      // Memory only
+    } LibLLVMCostQuery;
+
+    typedef struct LibLLVMCostResult
+    {
+        int64_t Cost;
+        LLVMBool IsValid;           // False if the operation is not supported (Cost is 0)
+    } LibLLVMCostResult;
+
+    // Computes the cost of each query of a batch; results is an array with at least numQueries elements. A query
+    // with an invalid kind, opcode or type is an error for the batch (and none of the results are valid).
+    LLVMErrorRef LibLLVMTargetTransformInfoGetCosts( LibLLVMTargetTransformInfoRef tti
+                                                   , LibLLVMTargetCostKind costKind
+                                                   , LibLLVMCostQuery const* queries
+                                                   , size_t numQueries
+                                                   , /*(OUT, LibLLVMCostResult[numQueries])*/ LibLLVMCostResult* results
+                                                   );
+LLVM_C_EXTERN_C_END
+
+#endif
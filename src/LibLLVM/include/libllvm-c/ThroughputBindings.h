@@ -0,0 +1,81 @@
+#ifndef _LIBLLVM_THROUGHPUT_BINDINGS_H_
+#define _LIBLLVM_THROUGHPUT_BINDINGS_H_
+
+#include <stdint.h>
+#include "llvm-c/Core.h"
+#include "llvm-c/Error.h"
+
+LLVM_C_EXTERN_C_BEGIN
+    // Static throughput analysis of machine code with the llvm-mca engine. The code is simulated on the
+    // scheduling model of the CPU for a number of iterations of the block, as if it was the body of a loop.
+    // The target for the triple MUST have the TargetMachine registered (and the AsmParser to analyze assembly
+    // or the Disassembler to analyze code bytes). An analyzer is immutable once created so it is safe to use
+    // from multiple threads at once.
+    typedef struct LibLLVMOpaqueThroughputAnalyzer* LibLLVMThroughputAnalyzerRef;
+
+    // Creates an analyzer; none of the strings are required to be nul terminated and the features are optional.
+    // The cpu is required and it MUST have a scheduling model (i.e. "skylake" or "znver3"; the generic CPU of many
+    // targets does not have one).
+    LLVMErrorRef LibLLVMCreateThroughputAnalyzer( char const* triple
+                                                , size_t tripleLen
+                                                , char const* cpu
+                                                , size_t cpuLen
+                                                , char const* features
+                                                , size_t featuresLen
+                                                , /*[out]*/ LibLLVMThroughputAnalyzerRef* outRetVal
+                                                );
+
+    void LibLLVMDisposeThroughputAnalyzer( LibLLVMThroughputAnalyzerRef analyzer );
+
+    typedef struct LibLLVMThroughputSummary
+    {
+        uint32_t Iterations;
+        uint32_t NumInstructions;               // Instructions in one iteration of the block
+        uint64_t TotalCycles;                   // Cycles for all iterations
+        uint64_t TotalMicroOps;                 // Micro ops for all iterations
+        uint32_t DispatchWidth;
+        double IPC;                             // Instructions per cycle
+        double MicroOpsPerCycle;
+        double BlockReciprocalThroughput;       // Cycles per iteration of the block in steady state
+    } LibLLVMThroughputSummary;
+
+    // Pressure on a single unit of a processor resource (i.e. an execution port)
+    typedef struct LibLLVMResourcePressure
+    {
+        char const* Name;                       // Name of the resource in the scheduling model; NOT nul terminated
+        size_t NameLen;
+        uint32_t ResourceIndex;                 // Index of the resource in the scheduling model
+        uint32_t Unit;                          // Unit of a resource with more than one unit; 0 otherwise
+        double CyclesPerIteration;              // Average cycles the unit is used in each iteration of the block
+    } LibLLVMResourcePressure;
+
+    typedef struct LibLLVMOpaqueThroughputResults* LibLLVMThroughputResultsRef;
+
+    // Analyzes a block of assembly text; Only the instructions of the text are analyzed (directives and
+    // labels are ignored). iterations of 0 uses the default of llvm-mca (100). The results MUST be disposed
+    // with LibLLVMDisposeThroughputResults().
+    LLVMErrorRef LibLLVMAnalyzeThroughputAsm( LibLLVMThroughputAnalyzerRef analyzer
+                                            , char const* text
+                                            , size_t textLen
+                                            , uint32_t iterations
+                                            , /*[out]*/ LibLLVMThroughputResultsRef* outResults
+                                            );
+
+    // Analyzes a block of machine code bytes (i.e. the bytes of a function from the object file emitted for a
+    // module by a TargetMachine, see: LibLLVMMappedObjectFileGetSymbols()). All bytes MUST be valid instructions.
+    LLVMErrorRef LibLLVMAnalyzeThroughputCode( LibLLVMThroughputAnalyzerRef analyzer
+                                             , uint8_t const* bytes
+                                             , uint64_t numBytes
+                                             , uint32_t iterations
+                                             , /*[out]*/ LibLLVMThroughputResultsRef* outResults
+                                             );
+
+    void LibLLVMDisposeThroughputResults( LibLLVMThroughputResultsRef results );
+
+    void LibLLVMThroughputResultsGetSummary( LibLLVMThroughputResultsRef results, /*[out]*/ LibLLVMThroughputSummary* summary );
+
+    // Gets the pressure on each unit of every processor resource of the scheduling model (including unused units)
+    LibLLVMResourcePressure const* LibLLVMThroughputResultsGetResourcePressure( LibLLVMThroughputResultsRef results, /*[out]*/ size_t* numResources );
+LLVM_C_EXTERN_C_END
+
+#endif
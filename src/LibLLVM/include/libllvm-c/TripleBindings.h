@@ -1,6 +1,8 @@
 #ifndef LLVM_TRIPLE_BINDINGS_H
 #define LLVM_TRIPLE_BINDINGS_H
+#include <stdint.h>
 #include <llvm-c\Types.h>
+#include <llvm-c\Error.h>
 
 LLVM_C_EXTERN_C_BEGIN
     enum LibLLVMTripleArchType
@@ -289,6 +291,30 @@ LLVM_C_EXTERN_C_BEGIN
 
     typedef struct LibLLVMOpaqueTriple* LibLLVMTripleRef;
 
+    typedef struct LibLLVMTripleVersion
+    {
+        uint32_t Major;
+        uint32_t Minor;
+        uint32_t Subminor;
+        uint32_t Build;
+    } LibLLVMTripleVersion;
+
+    // All of the decoded components of a triple in a single blittable structure
+    typedef struct LibLLVMDecodedTriple
+    {
+        LibLLVMTripleArchType ArchType;
+        LibLLVMTripleSubArchType SubArchType;
+        LibLLVMTripleVendorType VendorType;
+        LibLLVMTripleOSType OsType;
+        LibLLVMTripleEnvironmentType EnvironmentType;
+        LibLLVMTripleObjectFormatType ObjectFormatType;
+        LibLLVMTripleVersion OsVersion;
+        LibLLVMTripleVersion EnvironmentVersion;
+        uint32_t PointerBitWidth;   // 16, 32, 64 or 0 if not known for the architecture
+        LLVMBool IsLittleEndian;
+        LLVMBool HasEnvironment;
+    } LibLLVMDecodedTriple;
+
     LibLLVMTripleRef LibLLVMGetHostTriple();
     LibLLVMTripleRef LibLLVMParseTriple( char const* triple );
     void LibLLVMDisposeTriple( LibLLVMTripleRef triple );
@@ -303,10 +329,34 @@ LLVM_C_EXTERN_C_BEGIN
     void LibLLVMTripleGetEnvironmentVersion( LibLLVMTripleRef triple, unsigned* major, unsigned* minor, unsigned* build );
     LibLLVMTripleObjectFormatType LibLLVMTripleGetObjectFormatType( LibLLVMTripleRef triple );
 
+    // Decodes all of the components of a triple in a single call
+    LLVMErrorRef LibLLVMTripleDecode( LibLLVMTripleRef triple, /*[out, byref]*/ LibLLVMDecodedTriple* pDecoded );
+
+    // Decodes an array of triple strings; results is an array with at least numTriples elements.
+    // Each string is interned (see: LibLLVMInternTriple()) so repeated decoding of the same strings
+    // only parses them once.
+    LLVMErrorRef LibLLVMTripleDecodeStrings( char const* const* triples, size_t numTriples, /*(OUT, LibLLVMDecodedTriple[numTriples])*/ LibLLVMDecodedTriple* results );
+
     // Use LLVMDisposeMessage on return for this one as normalize param
     // may place string result on stack so a pointer to it as a return is bogus.
     char const* LibLLVMTripleAsString( LibLLVMTripleRef triple, LLVMBool normalize );
 
+    // Gets the string of the triple; The triple is normalized when parsed so this is the normalized form.
+    // The return is NOT nul terminated and refers to the storage of the triple so it is valid only for
+    // the lifetime of the triple. (The lifetime of the process for an interned triple)
+    char const* LibLLVMTripleGetString( LibLLVMTripleRef triple, /*[Out]*/ size_t* len );
+
+    // Interned triples
+    // An interned triple is an immutable triple held in a process wide, thread safe, table. Interning the
+    // same string (or any string with the same normalized form) always produces the same handle so the
+    // string is parsed and normalized only once per process. Since the decoded components of a triple are
+    // stored in the triple, queries on the handle are simple reads. An interned handle lives for the
+    // lifetime of the process; Calling LibLLVMDisposeTriple() on it is allowed but is a NOP. Two interned
+    // handles are equal if, and only if, they are the same handle.
+    LibLLVMTripleRef LibLLVMInternTriple( char const* triple, size_t len );
+    LibLLVMTripleRef LibLLVMGetInternedHostTriple( );
+    LLVMBool LibLLVMTripleIsInterned( LibLLVMTripleRef triple );
+
     // Raw static pointer used for return of each of these
     char const* LibLLVMTripleGetArchTypeName( LibLLVMTripleArchType type );
     char const* LibLLVMTripleGetVendorTypeName( LibLLVMTripleVendorType vendor );
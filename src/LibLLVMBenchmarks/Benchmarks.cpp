@@ -0,0 +1,577 @@
+// Micro benchmarks of the extended C API of the LibLLVM library
+//
+// Each benchmark measures one family of LibLLVM* entry points as a consumer (i.e. the .NET bindings)
+// calls them so that regressions in the binding layer are visible independent of LLVM itself. The
+// benchmarks that operate on IR use a synthetic module with a configurable number of functions
+// (see: --libllvm_sizes) where each function has attributes, a comdat and a metadata node.
+//
+// This uses Google Benchmark as built from the LLVM source tree (see: New-LlvmCmakeConfig -Benchmarks)
+// so all of the standard benchmark options (--benchmark_filter, --benchmark_format=json, etc...) apply.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <llvm-c/Analysis.h>
+#include <llvm-c/Core.h>
+#include <llvm-c/Error.h>
+#include <llvm-c/Target.h>
+
+#include "libllvm-c/AnalysisBindings.h"
+#include "libllvm-c/AttributeBindings.h"
+#include "libllvm-c/DataLayoutBindings.h"
+#include "libllvm-c/MetadataBindings.h"
+#include "libllvm-c/ModuleBindings.h"
+#include "libllvm-c/TargetRegistrationBindings.h"
+#include "libllvm-c/TripleBindings.h"
+
+namespace
+{
+    constexpr char const* SyntheticNodesName = "libllvm.bench.nodes";
+
+    constexpr char const* SampleTriples[] = {
+        "x86_64-pc-windows-msvc",
+        "x86_64-unknown-linux-gnu",
+        "aarch64-apple-macosx14.0.0",
+        "armv7a-unknown-linux-gnueabihf",
+        "riscv64-unknown-elf",
+        "wasm32-unknown-wasi",
+        "nvptx64-nvidia-cuda",
+        "thumbv7em-none-eabi",
+    };
+
+    constexpr char const* SampleDataLayouts[] = {
+        "e-m:w-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128",
+        "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128",
+        "e-m:o-i64:64-i128:128-n32:64-S128-Fn32",
+        "e-m:e-p:32:32-Fi8-i64:64-v128:64:128-a:0:32-n32-S64",
+        "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128",
+    };
+
+    constexpr size_t NumSampleTriples = sizeof(SampleTriples) / sizeof(SampleTriples[0]);
+    constexpr size_t NumSampleDataLayouts = sizeof(SampleDataLayouts) / sizeof(SampleDataLayouts[0]);
+
+    // Sizes (number of functions) of the synthetic modules; Replaced by the --libllvm_sizes option
+    std::vector<int64_t> ModuleSizes = { 16, 256, 4096 };
+
+    // Number of strings in a batch for the benchmarks of the batch APIs (i.e. LibLLVMTripleDecodeStrings)
+    constexpr int64_t StringCounts[] = { 1, 16, 256 };
+
+    void ConsumeError(LLVMErrorRef err, benchmark::State& state)
+    {
+        if (err != nullptr)
+        {
+            char* msg = LLVMGetErrorMessage(err);
+            state.SkipWithError(msg);
+            LLVMDisposeErrorMessage(msg);
+        }
+    }
+
+    // Module with a configurable number of functions, each of which has:
+    //  * function, return and parameter attributes (including a string attribute)
+    //  * a comdat of the same name as the function
+    //  * a metadata tuple with a string, a constant and a reference to the node of the previous function
+    //    that is an operand of the named metadata SyntheticNodesName
+    class SyntheticModule
+    {
+    public:
+        explicit SyntheticModule(int64_t numFunctions)
+            : Context(LLVMContextCreate())
+            , Module(LLVMModuleCreateWithNameInContext("libllvm.bench", Context))
+        {
+            LLVMTypeRef i32Type = LLVMInt32TypeInContext(Context);
+            LLVMTypeRef paramTypes[] = { i32Type, LLVMPointerTypeInContext(Context, 0) };
+            LLVMTypeRef fnType = LLVMFunctionType(i32Type, paramTypes, 2, 0);
+
+            LLVMAttributeRef fnAttributes[] = {
+                LLVMCreateEnumAttribute(Context, LLVMGetEnumAttributeKindForName("nounwind", 8), 0),
+                LLVMCreateEnumAttribute(Context, LLVMGetEnumAttributeKindForName("willreturn", 10), 0),
+                LLVMCreateStringAttribute(Context, "libllvm-bench", 13, "true", 4),
+            };
+
+            LLVMAttributeRef noUndef = LLVMCreateEnumAttribute(Context, LLVMGetEnumAttributeKindForName("noundef", 7), 0);
+            LLVMAttributeRef noCapture = LLVMCreateEnumAttribute(Context, LLVMGetEnumAttributeKindForName("nocapture", 9), 0);
+
+            LLVMBuilderRef builder = LLVMCreateBuilderInContext(Context);
+            LLVMMetadataRef previousNode = nullptr;
+            Functions.reserve(static_cast<size_t>(numFunctions));
+            for (int64_t i = 0; i < numFunctions; ++i)
+            {
+                std::string name = "f_" + std::to_string(i);
+                LLVMValueRef fn = LLVMAddFunction(Module, name.c_str(), fnType);
+                for (LLVMAttributeRef attrib : fnAttributes)
+                {
+                    LLVMAddAttributeAtIndex(fn, LLVMAttributeFunctionIndex, attrib);
+                }
+
+                LLVMAddAttributeAtIndex(fn, LLVMAttributeReturnIndex, noUndef);
+                LLVMAddAttributeAtIndex(fn, 1, noUndef);
+                LLVMAddAttributeAtIndex(fn, 2, noCapture);
+                LLVMSetComdat(fn, LLVMGetOrInsertComdat(Module, name.c_str()));
+
+                LLVMPositionBuilderAtEnd(builder, LLVMAppendBasicBlockInContext(Context, fn, "entry"));
+                LLVMValueRef sum = LLVMBuildAdd(builder, LLVMGetParam(fn, 0), LLVMConstInt(i32Type, static_cast<unsigned long long>(i), 0), "sum");
+                LLVMBuildRet(builder, sum);
+
+                LLVMMetadataRef operands[] = {
+                    LLVMMDStringInContext2(Context, name.c_str(), name.size()),
+                    LLVMValueAsMetadata(LLVMConstInt(i32Type, static_cast<unsigned long long>(i), 0)),
+                    previousNode,
+                };
+
+                previousNode = LLVMMDNodeInContext2(Context, operands, previousNode == nullptr ? 2 : 3);
+                LLVMAddNamedMetadataOperand(Module, SyntheticNodesName, LLVMMetadataAsValue(Context, previousNode));
+                Functions.push_back(fn);
+            }
+
+            LLVMDisposeBuilder(builder);
+        }
+
+        ~SyntheticModule()
+        {
+            LLVMDisposeModule(Module);
+            LLVMContextDispose(Context);
+        }
+
+        SyntheticModule(SyntheticModule const&) = delete;
+        SyntheticModule& operator=(SyntheticModule const&) = delete;
+
+        LLVMContextRef const Context;
+        LLVMModuleRef const Module;
+        std::vector<LLVMValueRef> Functions;
+    };
+
+    //--- Triple
+
+    void BM_TripleParse(benchmark::State& state)
+    {
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            LibLLVMTripleRef triple = LibLLVMParseTriple(SampleTriples[i++ % NumSampleTriples]);
+            benchmark::DoNotOptimize(LibLLVMTripleGetArchType(triple));
+            LibLLVMDisposeTriple(triple);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_TripleIntern(benchmark::State& state)
+    {
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            char const* str = SampleTriples[i++ % NumSampleTriples];
+            benchmark::DoNotOptimize(LibLLVMInternTriple(str, std::strlen(str)));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_TripleDecode(benchmark::State& state)
+    {
+        std::vector<LibLLVMTripleRef> triples;
+        for (char const* str : SampleTriples)
+        {
+            triples.push_back(LibLLVMParseTriple(str));
+        }
+
+        LibLLVMDecodedTriple decoded;
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            ConsumeError(LibLLVMTripleDecode(triples[i++ % NumSampleTriples], &decoded), state);
+            benchmark::DoNotOptimize(decoded);
+        }
+
+        for (LibLLVMTripleRef triple : triples)
+        {
+            LibLLVMDisposeTriple(triple);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_TripleDecodeStrings(benchmark::State& state)
+    {
+        std::vector<char const*> strings(static_cast<size_t>(state.range(0)));
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            strings[i] = SampleTriples[i % NumSampleTriples];
+        }
+
+        std::vector<LibLLVMDecodedTriple> results(strings.size());
+        for (auto _ : state)
+        {
+            ConsumeError(LibLLVMTripleDecodeStrings(strings.data(), strings.size(), results.data()), state);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //--- DataLayout
+
+    void BM_DataLayoutParse(benchmark::State& state)
+    {
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            char const* str = SampleDataLayouts[i++ % NumSampleDataLayouts];
+            LLVMTargetDataRef layout = nullptr;
+            ConsumeError(LibLLVMParseDataLayout(str, std::strlen(str), &layout), state);
+            LLVMDisposeTargetData(layout);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_DataLayoutIntern(benchmark::State& state)
+    {
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            char const* str = SampleDataLayouts[i++ % NumSampleDataLayouts];
+            LLVMTargetDataRef layout = nullptr;
+            ConsumeError(LibLLVMInternDataLayout(str, std::strlen(str), &layout), state);
+            benchmark::DoNotOptimize(layout);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_DataLayoutGetString(benchmark::State& state)
+    {
+        LLVMTargetDataRef layout = nullptr;
+        ConsumeError(LibLLVMParseDataLayout(SampleDataLayouts[0], std::strlen(SampleDataLayouts[0]), &layout), state);
+        for (auto _ : state)
+        {
+            size_t len = 0;
+            benchmark::DoNotOptimize(LibLLVMGetDataLayoutString(layout, &len));
+        }
+
+        LLVMDisposeTargetData(layout);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //--- Attributes
+
+    void BM_AttributeInfoByName(benchmark::State& state)
+    {
+        size_t numEntries = 0;
+        LibLLVMAttributeTableEntry const* table = LibLLVMGetAttributeInfoTable(&numEntries);
+
+        // entry 0 is for string attributes and has no name
+        std::vector<std::string> names;
+        for (size_t i = 1; i < numEntries; ++i)
+        {
+            names.emplace_back(table[i].Name, table[i].NameLen);
+        }
+
+        LibLLVMAttributeInfo info;
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            std::string& name = names[i++ % names.size()];
+            ConsumeError(LibLLVMGetAttributeInfo(name.data(), name.size(), &info), state);
+            benchmark::DoNotOptimize(info);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_AttributeGetRecords(benchmark::State& state)
+    {
+        SyntheticModule module(state.range(0));
+        std::vector<LibLLVMAttributeRecord> records;
+        for (auto _ : state)
+        {
+            for (LLVMValueRef fn : module.Functions)
+            {
+                records.resize(LibLLVMGetAttributeRecordCount(fn));
+                ConsumeError(LibLLVMGetAttributeRecords(fn, records.data(), records.size()), state);
+                benchmark::ClobberMemory();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_AttributeToStringBuffer(benchmark::State& state)
+    {
+        SyntheticModule module(state.range(0));
+        char buffer[1024];
+        for (auto _ : state)
+        {
+            for (LLVMValueRef fn : module.Functions)
+            {
+                benchmark::DoNotOptimize(LibLLVMAttributesToStringBuffer(fn, buffer, sizeof(buffer)));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //--- Metadata
+
+    void BM_MetadataOperandWalk(benchmark::State& state)
+    {
+        SyntheticModule module(state.range(0));
+        LLVMNamedMDNodeRef namedNode = LLVMGetNamedMetadata(module.Module, SyntheticNodesName, std::strlen(SyntheticNodesName));
+        for (auto _ : state)
+        {
+            unsigned numNodes = LibLLVMNamedMDNodeGetNumOperands(namedNode);
+            for (unsigned i = 0; i < numNodes; ++i)
+            {
+                LLVMMetadataRef node = LibLLVMNamedMDNodeGetOperand(namedNode, i);
+                uint32_t numOperands = LibLLVMMDNodeGetNumOperands(node);
+                for (uint32_t j = 0; j < numOperands; ++j)
+                {
+                    LLVMMetadataRef operand = LibLLVMGetOperandNode(LibLLVMMDNodeGetOperand(node, j));
+                    benchmark::DoNotOptimize(LibLLVMGetMetadataID(operand));
+                }
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //--- Comdat
+
+    void BM_ComdatIterate(benchmark::State& state)
+    {
+        SyntheticModule module(state.range(0));
+        LibLLVMComdatIteratorRef it = LibLLVMModuleBeginComdats(module.Module);
+        for (auto _ : state)
+        {
+            LibLLVMModuleComdatIteratorReset(it);
+            do
+            {
+                size_t len = 0;
+                benchmark::DoNotOptimize(LibLLVMComdatGetName(LibLLVMCurrentComdat(it), &len));
+            } while (LibLLVMMoveNextComdat(it));
+        }
+
+        LibLLVMDisposeComdatIterator(it);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ComdatLookup(benchmark::State& state)
+    {
+        SyntheticModule module(state.range(0));
+        std::vector<std::string> names;
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            names.push_back("f_" + std::to_string(i));
+        }
+
+        for (auto _ : state)
+        {
+            for (std::string const& name : names)
+            {
+                benchmark::DoNotOptimize(LibLLVMModuleGetComdat(module.Module, name.c_str()));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //--- Target registration
+
+    // After the first iteration this measures the cost of the already registered fast path, which
+    // is what every registration call after the first (i.e. for each new context) pays.
+    void BM_TargetRegisterNative(benchmark::State& state)
+    {
+        for (auto _ : state)
+        {
+            ConsumeError(LibLLVMRegisterTarget(CodeGenTarget_Native, TargetRegistration_All), state);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_TargetRegistrationInfos(benchmark::State& state)
+    {
+        std::vector<LibLLVMTargetRegistrationInfo> infos(static_cast<size_t>(LibLLVMGetNumTargetRegistrationInfos()));
+        for (auto _ : state)
+        {
+            ConsumeError(LibLLVMGetTargetRegistrationInfos(infos.data(), static_cast<int32_t>(infos.size())), state);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //--- Verification
+
+    void BM_VerifyFunctions(benchmark::State& state)
+    {
+        SyntheticModule module(state.range(0));
+        for (auto _ : state)
+        {
+            for (LLVMValueRef fn : module.Functions)
+            {
+                char* msg = nullptr;
+                if (LibLLVMVerifyFunctionEx(fn, LLVMReturnStatusAction, &msg))
+                {
+                    state.SkipWithError(msg);
+                }
+
+                LLVMDisposeMessage(msg);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_VerifyModule(benchmark::State& state)
+    {
+        SyntheticModule module(state.range(0));
+        for (auto _ : state)
+        {
+            char* msg = nullptr;
+            if (LLVMVerifyModule(module.Module, LLVMReturnStatusAction, &msg))
+            {
+                state.SkipWithError(msg);
+            }
+
+            LLVMDisposeMessage(msg);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    using BenchmarkFunction = void (*)(benchmark::State&);
+
+    // What the argument (state.range(0)) of a benchmark is
+    enum class BenchmarkArg
+    {
+        None,
+        ModuleSize,     // Number of functions in the synthetic module
+        StringCount,    // Number of strings in a batch
+    };
+
+    struct BenchmarkEntry
+    {
+        char const* Name;
+        BenchmarkFunction Function;
+        BenchmarkArg Arg;
+    };
+
+    constexpr BenchmarkEntry Benchmarks[] = {
+        { "TripleParse",             BM_TripleParse,                BenchmarkArg::None },
+        { "TripleIntern",            BM_TripleIntern,               BenchmarkArg::None },
+        { "TripleDecode",            BM_TripleDecode,               BenchmarkArg::None },
+        { "TripleDecodeStrings",     BM_TripleDecodeStrings,        BenchmarkArg::StringCount },
+        { "DataLayoutParse",         BM_DataLayoutParse,            BenchmarkArg::None },
+        { "DataLayoutIntern",        BM_DataLayoutIntern,           BenchmarkArg::None },
+        { "DataLayoutGetString",     BM_DataLayoutGetString,        BenchmarkArg::None },
+        { "AttributeInfoByName",     BM_AttributeInfoByName,        BenchmarkArg::None },
+        { "AttributeGetRecords",     BM_AttributeGetRecords,        BenchmarkArg::ModuleSize },
+        { "AttributeToStringBuffer", BM_AttributeToStringBuffer,    BenchmarkArg::ModuleSize },
+        { "MetadataOperandWalk",     BM_MetadataOperandWalk,        BenchmarkArg::ModuleSize },
+        { "ComdatIterate",           BM_ComdatIterate,              BenchmarkArg::ModuleSize },
+        { "ComdatLookup",            BM_ComdatLookup,               BenchmarkArg::ModuleSize },
+        { "TargetRegisterNative",    BM_TargetRegisterNative,       BenchmarkArg::None },
+        { "TargetRegistrationInfos", BM_TargetRegistrationInfos,    BenchmarkArg::None },
+        { "VerifyFunctions",         BM_VerifyFunctions,            BenchmarkArg::ModuleSize },
+        { "VerifyModule",            BM_VerifyModule,               BenchmarkArg::ModuleSize },
+    };
+
+    // Parses and removes the options specific to this program; All other options are left for
+    // benchmark::Initialize().
+    //  --libllvm_sizes=<n>[,<n>...]    Sizes (number of functions) of the synthetic modules
+    bool ParseOptions(int& argc, char** argv)
+    {
+        constexpr char const SizesOption[] = "--libllvm_sizes=";
+        constexpr size_t SizesOptionLen = sizeof(SizesOption) - 1;
+
+        int outIndex = 1;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strncmp(argv[i], SizesOption, SizesOptionLen) != 0)
+            {
+                argv[outIndex++] = argv[i];
+                continue;
+            }
+
+            ModuleSizes.clear();
+            char const* pos = argv[i] + SizesOptionLen;
+            while (*pos != '\0')
+            {
+                char* end = nullptr;
+                long long size = std::strtoll(pos, &end, 10);
+                if (end == pos || size <= 0 || (*end != ',' && *end != '\0'))
+                {
+                    std::fprintf(stderr, "Invalid value for %s'%s'\n", SizesOption, argv[i] + SizesOptionLen);
+                    return false;
+                }
+
+                ModuleSizes.push_back(size);
+                pos = *end == ',' ? end + 1 : end;
+            }
+        }
+
+        argc = outIndex;
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (!ParseOptions(argc, argv))
+    {
+        return EXIT_FAILURE;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Registration is done once up front so that it is not part of any benchmark other than
+    // BM_TargetRegisterNative, which intentionally measures the repeated (already registered) path.
+    LLVMErrorRef err = LibLLVMRegisterTarget(CodeGenTarget_Native, TargetRegistration_All);
+    if (err != nullptr)
+    {
+        char* msg = LLVMGetErrorMessage(err);
+        std::fprintf(stderr, "Target registration failed: %s\n", msg);
+        LLVMDisposeErrorMessage(msg);
+        return EXIT_FAILURE;
+    }
+
+    for (BenchmarkEntry const& entry : Benchmarks)
+    {
+        benchmark::internal::Benchmark* bm = benchmark::RegisterBenchmark(entry.Name, entry.Function);
+        switch (entry.Arg)
+        {
+        case BenchmarkArg::ModuleSize:
+            bm->ArgName("functions");
+            for (int64_t size : ModuleSizes)
+            {
+                bm->Arg(size);
+            }
+            break;
+
+        case BenchmarkArg::StringCount:
+            bm->ArgName("strings");
+            for (int64_t count : StringCounts)
+            {
+                bm->Arg(count);
+            }
+            break;
+
+        case BenchmarkArg::None:
+            break;
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+// Regression tests of the context bindings
+#include <llvm-c/Analysis.h>
+#include <llvm-c/Core.h>
+
+#include "libllvm-c/ContextBindings.h"
+#include "LibLLVMTests.h"
+
+namespace
+{
+    constexpr char const* ReferencesName = "libllvm.test.refs";
+
+    // Module with a global and two constant expressions that refer to it; the first is referenced ONLY by
+    // metadata and the second is not referenced at all.
+    struct MetadataReferenceModule
+    {
+        MetadataReferenceModule()
+            : Context(LLVMContextCreate())
+            , Module(LLVMModuleCreateWithNameInContext("test", Context))
+        {
+            LLVMTypeRef i64 = LLVMInt64TypeInContext(Context);
+            LLVMTypeRef bytes = LLVMArrayType(LLVMInt8TypeInContext(Context), 16);
+            Global = LLVMAddGlobal(Module, bytes, "g");
+            LLVMSetInitializer(Global, LLVMConstNull(bytes));
+
+            LLVMValueRef referencedIndices[] = { LLVMConstInt(i64, 0, false), LLVMConstInt(i64, 4, false) };
+            Referenced = LLVMConstInBoundsGEP2(bytes, Global, referencedIndices, 2);
+
+            LLVMMetadataRef operand = LLVMValueAsMetadata(Referenced);
+            LLVMMetadataRef node = LLVMMDNodeInContext2(Context, &operand, 1);
+            LLVMAddNamedMetadataOperand(Module, ReferencesName, LLVMMetadataAsValue(Context, node));
+
+            LLVMValueRef unusedIndices[] = { LLVMConstInt(i64, 0, false), LLVMConstInt(i64, 8, false) };
+            LLVMConstInBoundsGEP2(bytes, Global, unusedIndices, 2);
+        }
+
+        ~MetadataReferenceModule()
+        {
+            LLVMDisposeModule(Module);
+            LLVMContextDispose(Context);
+        }
+
+        // Gets the constant held by the named metadata; null if the reference was dropped
+        LLVMValueRef GetReferencedConstant() const
+        {
+            if (LLVMGetNamedMetadataNumOperands(Module, ReferencesName) != 1)
+            {
+                return nullptr;
+            }
+
+            LLVMValueRef node = nullptr;
+            LLVMGetNamedMetadataOperands(Module, ReferencesName, &node);
+            return LLVMGetOperand(node, 0);
+        }
+
+        LLVMContextRef Context;
+        LLVMModuleRef Module;
+        LLVMValueRef Global = nullptr;
+        LLVMValueRef Referenced = nullptr;
+    };
+
+    bool TrimKeepsConstantsReferencedByMetadata()
+    {
+        MetadataReferenceModule test;
+
+        // Only the unreferenced expression is destroyed
+        TEST_CHECK(LibLLVMContextTrimUnusedConstants(test.Context) == 1);
+        TEST_CHECK(LibLLVMContextTrimUnusedConstants(test.Context) == 0);
+
+        LLVMValueRef referenced = test.GetReferencedConstant();
+        TEST_CHECK(referenced == test.Referenced);
+        TEST_CHECK(LLVMIsAConstantExpr(referenced) != nullptr);
+        TEST_CHECK(LLVMGetConstOpcode(referenced) == LLVMGetElementPtr);
+        TEST_CHECK(LLVMGetOperand(referenced, 0) == test.Global);
+        TEST_CHECK(!LLVMVerifyModule(test.Module, LLVMReturnStatusAction, nullptr));
+        return true;
+    }
+
+    bool ReachableIREstimateIncludesMetadataReferences()
+    {
+        MetadataReferenceModule test;
+
+        LibLLVMReachableIREstimate estimate;
+        TEST_CHECK(LibLLVMContextEstimateReachableIR(test.Context, &estimate) == nullptr);
+        TEST_CHECK(estimate.ModuleCount == 1);
+
+        // The unreferenced expression is not reachable from the module so only the referenced one is counted
+        TEST_CHECK(estimate.ExpressionConstants.Count == 1);
+        TEST_CHECK(estimate.UniquedMDNodes.Count == 1);
+        TEST_CHECK(estimate.DataConstants.Count == 0);
+        TEST_CHECK(estimate.Types.Count > 0);
+        return true;
+    }
+
+    bool PoolRecyclesContextsUpToTheLeaseLimit()
+    {
+        LibLLVMContextPoolRef pool = LibLLVMCreateContextPool(/*preWarmCount*/ 1, /*maxRetained*/ 0, /*maxLeasesPerContext*/ 2);
+
+        LLVMContextRef first = LibLLVMContextPoolLease(pool);
+        LibLLVMContextPoolRelease(pool, first);
+        TEST_CHECK(LibLLVMContextPoolGetIdleCount(pool) == 1);
+
+        // Second lease reaches the limit so the context is destroyed when it is returned
+        LLVMContextRef second = LibLLVMContextPoolLease(pool);
+        TEST_CHECK(second == first);
+        LibLLVMContextPoolRelease(pool, second);
+        TEST_CHECK(LibLLVMContextPoolGetIdleCount(pool) == 0);
+        TEST_CHECK(LibLLVMContextPoolGetLeasedCount(pool) == 0);
+
+        LibLLVMDisposeContextPool(pool);
+        return true;
+    }
+
+    bool PoolDoesNotRecycleContextsThatOwnModules()
+    {
+        LibLLVMContextPoolRef pool = LibLLVMCreateContextPool(/*preWarmCount*/ 0, /*maxRetained*/ 0, /*maxLeasesPerContext*/ 0);
+
+        LLVMContextRef context = LibLLVMContextPoolLease(pool);
+        LLVMModuleCreateWithNameInContext("leaked", context);
+        LibLLVMContextPoolRelease(pool, context);
+        TEST_CHECK(LibLLVMContextPoolGetIdleCount(pool) == 0);
+
+        context = LibLLVMContextPoolLease(pool);
+        LLVMDisposeModule(LLVMModuleCreateWithNameInContext("disposed", context));
+        LibLLVMContextPoolRelease(pool, context);
+        TEST_CHECK(LibLLVMContextPoolGetIdleCount(pool) == 1);
+
+        LibLLVMDisposeContextPool(pool);
+        return true;
+    }
+
+    constexpr TestCase Tests[] = {
+        { "TrimKeepsConstantsReferencedByMetadata", TrimKeepsConstantsReferencedByMetadata },
+        { "ReachableIREstimateIncludesMetadataReferences", ReachableIREstimateIncludesMetadataReferences },
+        { "PoolRecyclesContextsUpToTheLeaseLimit", PoolRecyclesContextsUpToTheLeaseLimit },
+        { "PoolDoesNotRecycleContextsThatOwnModules", PoolDoesNotRecycleContextsThatOwnModules },
+    };
+}
+
+TestTable GetContextBindingsTests()
+{
+    return { Tests, sizeof(Tests) / sizeof(Tests[0]) };
+}
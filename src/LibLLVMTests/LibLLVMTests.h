@@ -0,0 +1,38 @@
+// Common support for the regression tests of the extended C API of the LibLLVM library
+//
+// Each test is a function that returns true on success and reports the first failed check to stderr.
+// Each source file of tests provides a table of its tests that is run by main().
+//
+// The tests ONLY use the exported C API of the library so that they test the library as a consumer sees it.
+#ifndef _LIBLLVM_TESTS_H_
+#define _LIBLLVM_TESTS_H_
+
+#include <cstddef>
+#include <cstdio>
+
+#define TEST_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #condition); \
+            return false; \
+        } \
+    } while (false)
+
+struct TestCase
+{
+    char const* Name;
+    bool (*Run)();
+};
+
+struct TestTable
+{
+    TestCase const* Tests;
+    size_t NumTests;
+};
+
+TestTable GetContextBindingsTests();
+TestTable GetThroughputBindingsTests();
+
+#endif
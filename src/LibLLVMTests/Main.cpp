@@ -0,0 +1,24 @@
+// Runs all of the regression tests; The process exit code is the number of failed tests so that a build can
+// run this directly as a gate.
+#include "LibLLVMTests.h"
+
+int main()
+{
+    TestTable const tables[] = {
+        GetContextBindingsTests(),
+        GetThroughputBindingsTests(),
+    };
+
+    int numFailed = 0;
+    for (TestTable const& table : tables)
+    {
+        for (size_t i = 0; i < table.NumTests; ++i)
+        {
+            bool passed = table.Tests[i].Run();
+            std::printf("%s: %s\n", passed ? "PASS" : "FAIL", table.Tests[i].Name);
+            numFailed += passed ? 0 : 1;
+        }
+    }
+
+    return numFailed;
+}
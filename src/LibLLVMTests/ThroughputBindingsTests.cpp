@@ -0,0 +1,62 @@
+// Regression tests of the throughput analysis bindings
+#include <cmath>
+#include <cstring>
+
+#include "libllvm-c/TargetRegistrationBindings.h"
+#include "libllvm-c/ThroughputBindings.h"
+#include "LibLLVMTests.h"
+
+namespace
+{
+    // Dot product example of the llvm-mca documentation; llvm-mca -mtriple=x86_64-unknown-unknown -mcpu=btver2
+    // -iterations=300 reports:
+    //      Iterations:        300
+    //      Instructions:      900
+    //      Total Cycles:      611
+    //      Total uOps:        900
+    //      Dispatch Width:    2
+    //      Block RThroughput: 2.0
+    // The total cycles changed by one between releases of LLVM (610 in older documentation) so a small range
+    // is allowed for them; all other values come directly from the scheduling model.
+    constexpr char const* DotProduct =
+        "vmulps %xmm0, %xmm1, %xmm2\n"
+        "vhaddps %xmm2, %xmm2, %xmm3\n"
+        "vhaddps %xmm3, %xmm3, %xmm4\n";
+
+    bool DotProductMatchesLlvmMca()
+    {
+        TEST_CHECK(LibLLVMRegisterTarget(CodeGenTarget_X86, TargetRegistration_All) == nullptr);
+
+        constexpr char const* triple = "x86_64-unknown-unknown";
+        constexpr char const* cpu = "btver2";
+        LibLLVMThroughputAnalyzerRef analyzer = nullptr;
+        TEST_CHECK(LibLLVMCreateThroughputAnalyzer(triple, std::strlen(triple), cpu, std::strlen(cpu), nullptr, 0, &analyzer) == nullptr);
+
+        LibLLVMThroughputResultsRef results = nullptr;
+        LLVMErrorRef err = LibLLVMAnalyzeThroughputAsm(analyzer, DotProduct, std::strlen(DotProduct), 300, &results);
+        LibLLVMDisposeThroughputAnalyzer(analyzer);
+        TEST_CHECK(err == nullptr);
+
+        LibLLVMThroughputSummary summary;
+        LibLLVMThroughputResultsGetSummary(results, &summary);
+        LibLLVMDisposeThroughputResults(results);
+
+        TEST_CHECK(summary.Iterations == 300);
+        TEST_CHECK(summary.NumInstructions == 3);
+        TEST_CHECK(summary.TotalMicroOps == 900);
+        TEST_CHECK(summary.DispatchWidth == 2);
+        TEST_CHECK(std::fabs(summary.BlockReciprocalThroughput - 2.0) < 0.05);
+        TEST_CHECK(summary.TotalCycles >= 605 && summary.TotalCycles <= 615);
+        TEST_CHECK(std::fabs(summary.IPC - 900.0 / summary.TotalCycles) < 0.001);
+        return true;
+    }
+
+    constexpr TestCase Tests[] = {
+        { "DotProductMatchesLlvmMca", DotProductMatchesLlvmMca },
+    };
+}
+
+TestTable GetThroughputBindingsTests()
+{
+    return { Tests, sizeof(Tests) / sizeof(Tests[0]) };
+}
@@ -0,0 +1,652 @@
+// Representative workload for the LibLLVM library
+//
+// This exercises the common paths through the library as used by a language front end:
+// IR construction, verification, bitcode round trip, optimization pipelines, code generation
+// and ORC JIT execution. It is used as the training workload for a profile guided optimized
+// (PGO) build of the library AND to compare the performance of one build of the library to
+// another. (see: Build-LibLLVMAndPackage.ps1 -LtoPgo)
+//
+// When a corpus of bitcode files is provided (--corpus) the modules are parsed from the files
+// instead of synthesized, and each iteration compiles every module of the corpus for the native
+// target. This provides a macro benchmark of compile throughput that is repeatable across LLVM
+// version updates. (--json writes the results, including peak memory use and functions/sec)
+//
+// It ONLY uses the exported C API of the library so that it measures the library as a consumer
+// sees it.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <llvm-c/Analysis.h>
+#include <llvm-c/BitReader.h>
+#include <llvm-c/BitWriter.h>
+#include <llvm-c/Core.h>
+#include <llvm-c/Error.h>
+#include <llvm-c/LLJIT.h>
+#include <llvm-c/Orc.h>
+#include <llvm-c/Target.h>
+#include <llvm-c/TargetMachine.h>
+#include <llvm-c/Transforms/PassBuilder.h>
+
+#include "libllvm-c/TargetRegistrationBindings.h"
+
+namespace
+{
+    using WorkloadClock = std::chrono::steady_clock;
+
+    struct WorkloadOptions
+    {
+        int Iterations = 10;
+        int FunctionsPerModule = 50;
+        std::string Pipeline = "default<O2>";
+        std::vector<std::string> Corpus;
+        std::string JsonPath;
+        bool VerifyEach = false;
+        int InlinerThreshold = -1;
+    };
+
+    enum WorkloadStage
+    {
+        Stage_BuildIR,
+        Stage_Parse,
+        Stage_Verify,
+        Stage_Bitcode,
+        Stage_Optimize,
+        Stage_CodeGen,
+        Stage_Jit,
+        Stage_Count
+    };
+
+    constexpr char const* StageNames[Stage_Count] = {
+        "BuildIR",
+        "Parse",
+        "Verify",
+        "Bitcode",
+        "Optimize",
+        "CodeGen",
+        "Jit",
+    };
+
+    struct StageTimes
+    {
+        double Ms[Stage_Count] = {};
+    };
+
+    struct WorkloadResults
+    {
+        StageTimes Times;
+        std::uint64_t Modules = 0;
+        std::uint64_t Functions = 0;   // Number of defined functions in the modules before optimization
+    };
+
+    // Times a single stage, adding the elapsed time to the stage total
+    class StageTimer
+    {
+    public:
+        StageTimer(WorkloadResults& results, WorkloadStage stage)
+            : Times(results.Times)
+            , Stage(stage)
+            , Start(WorkloadClock::now())
+        {
+        }
+
+        ~StageTimer()
+        {
+            Times.Ms[Stage] += std::chrono::duration<double, std::milli>(WorkloadClock::now() - Start).count();
+        }
+
+    private:
+        StageTimes& Times;
+        WorkloadStage Stage;
+        WorkloadClock::time_point Start;
+    };
+
+    bool Succeeded(LLVMErrorRef err, char const* operation)
+    {
+        if (err == nullptr)
+        {
+            return true;
+        }
+
+        char* msg = LLVMGetErrorMessage(err);
+        std::fprintf(stderr, "%s failed: %s\n", operation, msg);
+        LLVMDisposeErrorMessage(msg);
+        return false;
+    }
+
+    bool ParseArgs(int argc, char** argv, WorkloadOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            bool hasValue = i + 1 < argc;
+            if (hasValue && std::strcmp(argv[i], "--iterations") == 0)
+            {
+                options.Iterations = std::atoi(argv[++i]);
+            }
+            else if (hasValue && std::strcmp(argv[i], "--functions") == 0)
+            {
+                options.FunctionsPerModule = std::atoi(argv[++i]);
+            }
+            else if (hasValue && std::strcmp(argv[i], "--pipeline") == 0)
+            {
+                options.Pipeline = argv[++i];
+            }
+            else if (hasValue && std::strcmp(argv[i], "--corpus") == 0)
+            {
+                options.Corpus.emplace_back(argv[++i]);
+            }
+            else if (hasValue && std::strcmp(argv[i], "--json") == 0)
+            {
+                options.JsonPath = argv[++i];
+            }
+            else if (hasValue && std::strcmp(argv[i], "--inliner-threshold") == 0)
+            {
+                options.InlinerThreshold = std::atoi(argv[++i]);
+            }
+            else if (std::strcmp(argv[i], "--verify-each") == 0)
+            {
+                options.VerifyEach = true;
+            }
+            else
+            {
+                std::fprintf(stderr, "usage: %s [--iterations <n>] [--functions <n>] [--pipeline <passes>] [--corpus <file|directory>]...\n"
+                                     "          [--json <file>] [--inliner-threshold <n>] [--verify-each]\n"
+                             , argv[0]
+                );
+                return false;
+            }
+        }
+
+        return options.Iterations > 0 && options.FunctionsPerModule > 0;
+    }
+
+    // Reads all of the bitcode files of the corpus into memory so that file I/O is not part of the
+    // measured time. Directories include all of the *.bc files they contain (NOT recursive).
+    bool LoadCorpus(std::vector<std::string> const& paths, std::vector<LLVMMemoryBufferRef>& buffers)
+    {
+        std::vector<std::filesystem::path> files;
+        for (std::string const& path : paths)
+        {
+            std::error_code ec;
+            if (!std::filesystem::is_directory(path, ec))
+            {
+                files.emplace_back(path);
+                continue;
+            }
+
+            for (auto const& entry : std::filesystem::directory_iterator(path, ec))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".bc")
+                {
+                    files.push_back(entry.path());
+                }
+            }
+        }
+
+        for (std::filesystem::path const& file : files)
+        {
+            LLVMMemoryBufferRef buffer = nullptr;
+            char* msg = nullptr;
+            if (LLVMCreateMemoryBufferWithContentsOfFile(file.string().c_str(), &buffer, &msg))
+            {
+                std::fprintf(stderr, "Failed to read '%s': %s\n", file.string().c_str(), msg);
+                LLVMDisposeMessage(msg);
+                return false;
+            }
+
+            buffers.push_back(buffer);
+        }
+
+        if (buffers.empty())
+        {
+            std::fprintf(stderr, "Corpus does not contain any bitcode files\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    std::uint64_t GetPeakResidentBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize : 0;
+#else
+        rusage usage;
+        // ru_maxrss is in kilobytes
+        return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<std::uint64_t>(usage.ru_maxrss) * 1024 : 0;
+#endif
+    }
+
+    void WriteJsonString(std::FILE* file, char const* str, size_t len)
+    {
+        std::fputc('"', file);
+        for (size_t i = 0; i < len; ++i)
+        {
+            unsigned char ch = static_cast<unsigned char>(str[i]);
+            if (ch == '"' || ch == '\\')
+            {
+                std::fprintf(file, "\\%c", ch);
+            }
+            else if (ch < 0x20)
+            {
+                std::fprintf(file, "\\u%04x", ch);
+            }
+            else
+            {
+                std::fputc(ch, file);
+            }
+        }
+
+        std::fputc('"', file);
+    }
+
+    bool WriteJsonReport(WorkloadOptions const& options, char const* triple, WorkloadResults const& results, double totalMs)
+    {
+        std::FILE* file = std::fopen(options.JsonPath.c_str(), "w");
+        if (file == nullptr)
+        {
+            std::fprintf(stderr, "Failed to open '%s'\n", options.JsonPath.c_str());
+            return false;
+        }
+
+        unsigned major = 0;
+        unsigned minor = 0;
+        unsigned patch = 0;
+        LLVMGetVersion(&major, &minor, &patch);
+
+        size_t versionLen = 0;
+        char const* libraryVersion = LibLLVMGetVersion(&versionLen);
+
+        std::fprintf(file, "{\n  \"libraryVersion\": ");
+        WriteJsonString(file, libraryVersion, versionLen);
+        std::fprintf(file, ",\n  \"llvmVersion\": \"%u.%u.%u\",\n  \"triple\": ", major, minor, patch);
+        WriteJsonString(file, triple, std::strlen(triple));
+        std::fprintf(file, ",\n  \"pipeline\": ");
+        WriteJsonString(file, options.Pipeline.c_str(), options.Pipeline.size());
+        std::fprintf(file, ",\n  \"source\": \"%s\",\n", options.Corpus.empty() ? "synthetic" : "corpus");
+        std::fprintf(file, "  \"iterations\": %d,\n", options.Iterations);
+        std::fprintf(file, "  \"modules\": %llu,\n", static_cast<unsigned long long>(results.Modules));
+        std::fprintf(file, "  \"functions\": %llu,\n", static_cast<unsigned long long>(results.Functions));
+        std::fprintf(file, "  \"stagesMs\": {");
+        for (int stage = 0; stage < Stage_Count; ++stage)
+        {
+            std::fprintf(file, "%s\n    \"%s\": %.3f", stage == 0 ? "" : ",", StageNames[stage], results.Times.Ms[stage]);
+        }
+
+        std::fprintf(file, "\n  },\n  \"totalMs\": %.3f,\n", totalMs);
+        std::fprintf(file, "  \"functionsPerSecond\": %.1f,\n", totalMs > 0 ? (results.Functions * 1000.0) / totalMs : 0.0);
+        std::fprintf(file, "  \"peakRssBytes\": %llu\n}\n", static_cast<unsigned long long>(GetPeakResidentBytes()));
+        return std::fclose(file) == 0;
+    }
+
+    std::uint64_t CountDefinedFunctions(LLVMModuleRef module)
+    {
+        std::uint64_t count = 0;
+        for (LLVMValueRef fn = LLVMGetFirstFunction(module); fn != nullptr; fn = LLVMGetNextFunction(fn))
+        {
+            if (!LLVMIsDeclaration(fn))
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    // Builds the equivalent of:
+    //  int64_t f_<index>(int64_t n)
+    //  {
+    //      int64_t acc = <index>;
+    //      for(int64_t i = 0; i < n; ++i)
+    //      {
+    //          acc = acc * 31 + (i ^ <index>);
+    //          acc = (acc & 1) ? acc + i : acc - <index>;
+    //      }
+    //      return acc;
+    //  }
+    // Along with a call to the previous function so there is something for the inliner to consider.
+    LLVMValueRef BuildFunction(LLVMModuleRef module, LLVMBuilderRef builder, LLVMValueRef previous, int index)
+    {
+        LLVMContextRef context = LLVMGetModuleContext(module);
+        LLVMTypeRef i64 = LLVMInt64TypeInContext(context);
+        LLVMTypeRef fnType = LLVMFunctionType(i64, &i64, 1, 0);
+
+        std::string name = "f_" + std::to_string(index);
+        LLVMValueRef fn = LLVMAddFunction(module, name.c_str(), fnType);
+        LLVMValueRef n = LLVMGetParam(fn, 0);
+        LLVMValueRef indexValue = LLVMConstInt(i64, static_cast<unsigned long long>(index), 0);
+
+        LLVMBasicBlockRef entry = LLVMAppendBasicBlockInContext(context, fn, "entry");
+        LLVMBasicBlockRef loop = LLVMAppendBasicBlockInContext(context, fn, "loop");
+        LLVMBasicBlockRef exit = LLVMAppendBasicBlockInContext(context, fn, "exit");
+
+        LLVMPositionBuilderAtEnd(builder, entry);
+        LLVMValueRef initial = indexValue;
+        if (previous != nullptr)
+        {
+            LLVMValueRef arg = LLVMConstInt(i64, 3, 0);
+            initial = LLVMBuildCall2(builder, fnType, previous, &arg, 1, "prev");
+        }
+
+        LLVMValueRef isEmpty = LLVMBuildICmp(builder, LLVMIntSLE, n, LLVMConstInt(i64, 0, 0), "empty");
+        LLVMBuildCondBr(builder, isEmpty, exit, loop);
+
+        LLVMPositionBuilderAtEnd(builder, loop);
+        LLVMValueRef i = LLVMBuildPhi(builder, i64, "i");
+        LLVMValueRef acc = LLVMBuildPhi(builder, i64, "acc");
+        LLVMValueRef scaled = LLVMBuildMul(builder, acc, LLVMConstInt(i64, 31, 0), "scaled");
+        LLVMValueRef mixed = LLVMBuildAdd(builder, scaled, LLVMBuildXor(builder, i, indexValue, "x"), "mixed");
+        LLVMValueRef isOdd = LLVMBuildTrunc(builder, mixed, LLVMInt1TypeInContext(context), "odd");
+        LLVMValueRef nextAcc = LLVMBuildSelect(builder, isOdd, LLVMBuildAdd(builder, mixed, i, "up"), LLVMBuildSub(builder, mixed, indexValue, "down"), "next");
+        LLVMValueRef nextI = LLVMBuildAdd(builder, i, LLVMConstInt(i64, 1, 0), "i.next");
+        LLVMValueRef done = LLVMBuildICmp(builder, LLVMIntSGE, nextI, n, "done");
+        LLVMBuildCondBr(builder, done, exit, loop);
+
+        LLVMValueRef iIncoming[] = { LLVMConstInt(i64, 0, 0), nextI };
+        LLVMValueRef accIncoming[] = { initial, nextAcc };
+        LLVMBasicBlockRef phiBlocks[] = { entry, loop };
+        LLVMAddIncoming(i, iIncoming, phiBlocks, 2);
+        LLVMAddIncoming(acc, accIncoming, phiBlocks, 2);
+
+        LLVMPositionBuilderAtEnd(builder, exit);
+        LLVMValueRef result = LLVMBuildPhi(builder, i64, "result");
+        LLVMValueRef resultIncoming[] = { initial, nextAcc };
+        LLVMAddIncoming(result, resultIncoming, phiBlocks, 2);
+        LLVMBuildRet(builder, result);
+        return fn;
+    }
+
+    LLVMModuleRef BuildModule(LLVMContextRef context, LLVMTargetMachineRef tm, char const* triple, int numFunctions)
+    {
+        LLVMModuleRef module = LLVMModuleCreateWithNameInContext("workload", context);
+        LLVMSetTarget(module, triple);
+
+        LLVMTargetDataRef layout = LLVMCreateTargetDataLayout(tm);
+        LLVMSetModuleDataLayout(module, layout);
+        LLVMDisposeTargetData(layout);
+
+        LLVMBuilderRef builder = LLVMCreateBuilderInContext(context);
+        LLVMValueRef previous = nullptr;
+        for (int i = 0; i < numFunctions; ++i)
+        {
+            previous = BuildFunction(module, builder, previous, i);
+        }
+
+        LLVMDisposeBuilder(builder);
+        return module;
+    }
+
+    // Verifies, optimizes, generates code for and JITs a module; Ownership of the module and the context
+    // transfer to this function. If lookupName isn't empty it is looked up to force materialization of the
+    // module and, if callEntry is true, called with an argument of 1000.
+    bool CompileModule(WorkloadOptions const& options
+                       , LLVMTargetMachineRef tm
+                       , LLVMOrcThreadSafeContextRef tsc
+                       , LLVMModuleRef module
+                       , std::string const& lookupName
+                       , bool callEntry
+                       , WorkloadResults& results
+                       )
+    {
+        {
+            StageTimer timer(results, Stage_Verify);
+            char* msg = nullptr;
+            if (LLVMVerifyModule(module, LLVMReturnStatusAction, &msg))
+            {
+                std::fprintf(stderr, "Verification failed: %s\n", msg);
+                LLVMDisposeMessage(msg);
+                LLVMDisposeModule(module);
+                LLVMOrcDisposeThreadSafeContext(tsc);
+                return false;
+            }
+
+            LLVMDisposeMessage(msg);
+        }
+
+        {
+            StageTimer timer(results, Stage_Optimize);
+            LLVMPassBuilderOptionsRef passOptions = LLVMCreatePassBuilderOptions();
+            LLVMPassBuilderOptionsSetVerifyEach(passOptions, options.VerifyEach);
+            if (options.InlinerThreshold >= 0)
+            {
+                LLVMPassBuilderOptionsSetInlinerThreshold(passOptions, options.InlinerThreshold);
+            }
+
+            LLVMErrorRef err = LLVMRunPasses(module, options.Pipeline.c_str(), tm, passOptions);
+            LLVMDisposePassBuilderOptions(passOptions);
+            if (!Succeeded(err, "Optimization"))
+            {
+                LLVMDisposeModule(module);
+                LLVMOrcDisposeThreadSafeContext(tsc);
+                return false;
+            }
+        }
+
+        {
+            StageTimer timer(results, Stage_CodeGen);
+            char* msg = nullptr;
+            LLVMMemoryBufferRef objBuffer = nullptr;
+            if (LLVMTargetMachineEmitToMemoryBuffer(tm, module, LLVMObjectFile, &msg, &objBuffer))
+            {
+                std::fprintf(stderr, "Code generation failed: %s\n", msg);
+                LLVMDisposeMessage(msg);
+                LLVMDisposeModule(module);
+                LLVMOrcDisposeThreadSafeContext(tsc);
+                return false;
+            }
+
+            LLVMDisposeMemoryBuffer(objBuffer);
+        }
+
+        {
+            StageTimer timer(results, Stage_Jit);
+            LLVMOrcLLJITRef jit = nullptr;
+            if (!Succeeded(LLVMOrcCreateLLJIT(&jit, LLVMOrcCreateLLJITBuilder()), "JIT creation"))
+            {
+                LLVMDisposeModule(module);
+                LLVMOrcDisposeThreadSafeContext(tsc);
+                return false;
+            }
+
+            // ownership of the module transfers to the JIT
+            LLVMOrcThreadSafeModuleRef tsm = LLVMOrcCreateNewThreadSafeModule(module, tsc);
+            LLVMOrcJITDylibRef mainLib = LLVMOrcLLJITGetMainJITDylib(jit);
+            bool ok = Succeeded(LLVMOrcLLJITAddLLVMIRModule(jit, mainLib, tsm), "JIT add module");
+
+            if (ok && !lookupName.empty())
+            {
+                LLVMOrcExecutorAddress fnAddress = 0;
+                ok = Succeeded(LLVMOrcLLJITLookup(jit, &fnAddress, lookupName.c_str()), "JIT lookup");
+                if (ok && callEntry)
+                {
+                    auto fn = reinterpret_cast<std::int64_t(*)(std::int64_t)>(fnAddress);
+                    volatile std::int64_t result = fn(1000);
+                    (void)result;
+                }
+            }
+
+            ok = Succeeded(LLVMOrcDisposeLLJIT(jit), "JIT dispose") && ok;
+            LLVMOrcDisposeThreadSafeContext(tsc);
+            return ok;
+        }
+    }
+
+    bool RunSyntheticIteration(WorkloadOptions const& options, LLVMTargetMachineRef tm, char const* triple, WorkloadResults& results)
+    {
+        LLVMOrcThreadSafeContextRef tsc = LLVMOrcCreateNewThreadSafeContext();
+        LLVMContextRef context = LLVMOrcThreadSafeContextGetContext(tsc);
+
+        LLVMModuleRef module = nullptr;
+        {
+            StageTimer timer(results, Stage_BuildIR);
+            module = BuildModule(context, tm, triple, options.FunctionsPerModule);
+        }
+
+        {
+            // round trip through bitcode as a front end caching modules would
+            StageTimer timer(results, Stage_Bitcode);
+            LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(module);
+            LLVMDisposeModule(module);
+            module = nullptr;
+
+            bool failed = LLVMParseBitcodeInContext2(context, bitcode, &module) != 0;
+            LLVMDisposeMemoryBuffer(bitcode);
+            if (failed)
+            {
+                std::fprintf(stderr, "Bitcode parse failed\n");
+                LLVMOrcDisposeThreadSafeContext(tsc);
+                return false;
+            }
+        }
+
+        ++results.Modules;
+        results.Functions += static_cast<std::uint64_t>(options.FunctionsPerModule);
+        std::string lastFunction = "f_" + std::to_string(options.FunctionsPerModule - 1);
+        return CompileModule(options, tm, tsc, module, lastFunction, true, results);
+    }
+
+    // Compiles every module of the corpus for the native target; The target and data layout of each module
+    // are replaced with the native ones so that a corpus generated on any host is usable.
+    bool RunCorpusIteration(WorkloadOptions const& options
+                            , LLVMTargetMachineRef tm
+                            , char const* triple
+                            , std::vector<LLVMMemoryBufferRef> const& corpus
+                            , WorkloadResults& results
+                            )
+    {
+        for (LLVMMemoryBufferRef bitcode : corpus)
+        {
+            LLVMOrcThreadSafeContextRef tsc = LLVMOrcCreateNewThreadSafeContext();
+            LLVMContextRef context = LLVMOrcThreadSafeContextGetContext(tsc);
+
+            LLVMModuleRef module = nullptr;
+            {
+                StageTimer timer(results, Stage_Parse);
+                if (LLVMParseBitcodeInContext2(context, bitcode, &module))
+                {
+                    std::fprintf(stderr, "Bitcode parse failed\n");
+                    LLVMOrcDisposeThreadSafeContext(tsc);
+                    return false;
+                }
+
+                LLVMSetTarget(module, triple);
+                LLVMTargetDataRef layout = LLVMCreateTargetDataLayout(tm);
+                LLVMSetModuleDataLayout(module, layout);
+                LLVMDisposeTargetData(layout);
+            }
+
+            // Look up the first defined function to force materialization; corpus functions are never called
+            // as there is no way to know what arguments they expect.
+            std::string lookupName;
+            for (LLVMValueRef fn = LLVMGetFirstFunction(module); fn != nullptr && lookupName.empty(); fn = LLVMGetNextFunction(fn))
+            {
+                if (!LLVMIsDeclaration(fn) && LLVMGetLinkage(fn) != LLVMInternalLinkage && LLVMGetLinkage(fn) != LLVMPrivateLinkage)
+                {
+                    size_t len = 0;
+                    char const* name = LLVMGetValueName2(fn, &len);
+                    lookupName.assign(name, len);
+                }
+            }
+
+            ++results.Modules;
+            results.Functions += CountDefinedFunctions(module);
+            if (!CompileModule(options, tm, tsc, module, lookupName, false, results))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    WorkloadOptions options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        return 1;
+    }
+
+    std::vector<LLVMMemoryBufferRef> corpus;
+    if (!options.Corpus.empty() && !LoadCorpus(options.Corpus, corpus))
+    {
+        return 1;
+    }
+
+    if (!Succeeded(LibLLVMRegisterTarget(CodeGenTarget_Native, TargetRegistration_All), "Target registration"))
+    {
+        return 1;
+    }
+
+    char* triple = LLVMGetDefaultTargetTriple();
+    char* errMsg = nullptr;
+    LLVMTargetRef target = nullptr;
+    if (LLVMGetTargetFromTriple(triple, &target, &errMsg))
+    {
+        std::fprintf(stderr, "Target lookup failed: %s\n", errMsg);
+        LLVMDisposeMessage(errMsg);
+        LLVMDisposeMessage(triple);
+        return 1;
+    }
+
+    char* cpu = LLVMGetHostCPUName();
+    char* features = LLVMGetHostCPUFeatures();
+    LLVMTargetMachineRef tm = LLVMCreateTargetMachine(target, triple, cpu, features, LLVMCodeGenLevelDefault, LLVMRelocDefault, LLVMCodeModelJITDefault);
+
+    WorkloadResults results;
+    int exitCode = 0;
+    auto start = WorkloadClock::now();
+    for (int i = 0; i < options.Iterations; ++i)
+    {
+        bool succeeded = corpus.empty()
+                       ? RunSyntheticIteration(options, tm, triple, results)
+                       : RunCorpusIteration(options, tm, triple, corpus, results);
+        if (!succeeded)
+        {
+            exitCode = 1;
+            break;
+        }
+    }
+
+    double totalMs = std::chrono::duration<double, std::milli>(WorkloadClock::now() - start).count();
+
+    // Tab separated "<stage>\t<ms>" lines for simple parsing by the build scripts
+    for (int stage = 0; stage < Stage_Count; ++stage)
+    {
+        std::printf("%s\t%.3f\n", StageNames[stage], results.Times.Ms[stage]);
+    }
+
+    std::printf("Total\t%.3f\n", totalMs);
+
+    if (exitCode == 0 && !options.JsonPath.empty() && !WriteJsonReport(options, triple, results, totalMs))
+    {
+        exitCode = 1;
+    }
+
+    for (LLVMMemoryBufferRef buffer : corpus)
+    {
+        LLVMDisposeMemoryBuffer(buffer);
+    }
+
+    LLVMDisposeTargetMachine(tm);
+    LLVMDisposeMessage(features);
+    LLVMDisposeMessage(cpu);
+    LLVMDisposeMessage(triple);
+    return exitCode;
+}
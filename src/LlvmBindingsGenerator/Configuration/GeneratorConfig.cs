@@ -1,6 +1,8 @@
 ﻿// Copyright (c) Ubiquity.NET Contributors. All rights reserved.
 // Licensed under the Apache-2.0 WITH LLVM-exception license. See the LICENSE.md file in the project root for full license information.
 
+using System;
+using System.Collections.Generic;
 using System.Collections.Immutable;
 
 namespace LlvmBindingsGenerator.Configuration
@@ -13,5 +15,26 @@ namespace LlvmBindingsGenerator.Configuration
                 "llvm-c/lto.h".NormalizePathSep(),
                 "llvm-c/Remarks.h".NormalizePathSep(),
             ];
+
+        public ImmutableDictionary<string, ImmutableArray<string>> ComponentHeaders { get; }
+            = new Dictionary<string, ImmutableArray<string>>()
+            {
+                // The throughput analysis parses assembly text and disassembles machine code so it needs both
+                ["AsmParser"] = [
+                    "libllvm-c/AssemblerBindings.h".NormalizePathSep(),
+                    "libllvm-c/ThroughputBindings.h".NormalizePathSep(),
+                ],
+                ["Disassembler"] = [
+                    "llvm-c/Disassembler.h".NormalizePathSep(),
+                    "libllvm-c/DisassemblerBindings.h".NormalizePathSep(),
+                    "libllvm-c/ThroughputBindings.h".NormalizePathSep(),
+                ],
+                ["ExecutionEngine"] = [ "llvm-c/ExecutionEngine.h".NormalizePathSep() ],
+                ["Linker"] = [ "llvm-c/Linker.h".NormalizePathSep() ],
+                ["Object"] = [
+                    "llvm-c/Object.h".NormalizePathSep(),
+                    "libllvm-c/ObjectFileBindings.h".NormalizePathSep(),
+                ],
+            }.ToImmutableDictionary(StringComparer.OrdinalIgnoreCase);
     }
 }
@@ -17,5 +17,12 @@ namespace LlvmBindingsGenerator.Configuration
     {
         /// <summary>Gets the Headers to ignore when parsing the input</summary>
         ImmutableArray<string> IgnoredHeaders { get; }
+
+        /// <summary>Gets the headers for each component that is optionally excluded from the exports</summary>
+        /// <remarks>
+        /// Excluding a component removes the APIs declared in its headers from the generated exports so that
+        /// the linker can discard the implementation of them for a reduced footprint build of the library.
+        /// </remarks>
+        ImmutableDictionary<string, ImmutableArray<string>> ComponentHeaders { get; }
     }
 }
@@ -3,7 +3,9 @@
 
 using System.Collections.Generic;
 using System.IO;
+using System.Linq;
 
+using CppSharp;
 using CppSharp.AST;
 
 using LlvmBindingsGenerator.Configuration;
@@ -77,7 +79,22 @@ namespace LlvmBindingsGenerator
             // always start the passes with the IgnoreSystemHeaders pass to ensure that
             // transformation only occurs for the desired headers. Other passes depend on
             // TranslationUnit.IsGenerated to ignore headers.
-            Driver!.AddTranslationUnitPass( new IgnoreSystemHeadersPass( Configuration.IgnoredHeaders ) );
+            // Options.Validate() reports unknown components, this only guards against a library created from
+            // options that were not validated so that an unknown name is a usage error and not an exception.
+            var excludedHeaders = new List<string>();
+            foreach(string component in CmdLineOptions.ExcludedComponents)
+            {
+                if(Configuration.ComponentHeaders.TryGetValue( component, out var componentHeaders ))
+                {
+                    excludedHeaders.AddRange( componentHeaders );
+                }
+                else
+                {
+                    Diagnostics.Error( "Unknown excluded component '{0}'; Valid components are: {1}.", component, string.Join( ", ", Configuration.ComponentHeaders.Keys.Order() ) );
+                }
+            }
+
+            Driver!.AddTranslationUnitPass( new IgnoreSystemHeadersPass( Configuration.IgnoredHeaders.AddRange( excludedHeaders ) ) );
             Driver!.AddTranslationUnitPass( new IgnoreDuplicateNamesPass( ) );
 
             // modifying pass(es)
@@ -1,15 +1,19 @@
 ﻿// Copyright (c) Ubiquity.NET Contributors. All rights reserved.
 // Licensed under the Apache-2.0 WITH LLVM-exception license. See the LICENSE.md file in the project root for full license information.
 
+using System.Collections.Generic;
 using System.Diagnostics.CodeAnalysis;
 using System.Globalization;
 using System.IO;
+using System.Linq;
 using System.Text;
 
 using CommandLine;
 
 using CppSharp;
 
+using LlvmBindingsGenerator.Configuration;
+
 namespace LlvmBindingsGenerator
 {
     [SuppressMessage("Build", "CA1812", Justification = "Instantiated via reflection from Command line parser" )]
@@ -21,6 +25,7 @@ namespace LlvmBindingsGenerator
             string? extensionsRoot,
             string? exportsDefFilePath,
             string? configPathRoot,
+            IEnumerable<string>? excludedComponents,
             DiagnosticKind diagnostics
             )
         {
@@ -35,6 +40,7 @@ namespace LlvmBindingsGenerator
             ExtensionsRoot = extensionsRoot is null ? string.Empty : Path.GetFullPath(extensionsRoot);
             ConfigPathRoot = configPathRoot is null ? string.Empty : Path.GetFullPath(configPathRoot);
             ExportsDefFilePath = exportsDefFilePath is null ? string.Empty : Path.GetFullPath(exportsDefFilePath);
+            ExcludedComponents = excludedComponents is null ? [] : [ .. excludedComponents ];
 
             Diagnostics = diagnostics;
         }
@@ -51,6 +57,9 @@ namespace LlvmBindingsGenerator
         [Option('d', HelpText = "Output path for the generated DEF file (For Windows LibLLVM.DLL). Not generated if this is not provided")]
         public string ExportsDefFilePath { get; } = string.Empty;
 
+        [Option('x', Separator = ';', HelpText = "Semicolon separated list of components to exclude from the exports for a reduced footprint library. (AsmParser, Disassembler, ExecutionEngine, Linker, Object)")]
+        public IEnumerable<string> ExcludedComponents { get; } = [];
+
         [Option( HelpText = "Diagnostics output level", Required = false, Default = DiagnosticKind.Message )]
         public DiagnosticKind Diagnostics { get; }
 
@@ -109,6 +118,16 @@ namespace LlvmBindingsGenerator
                 // If it doesn't exist, it will be created, no need to test for that here
             }
 
+            var config = new GeneratorConfig();
+            foreach(string component in ExcludedComponents)
+            {
+                if(!config.ComponentHeaders.ContainsKey(component))
+                {
+                    helpWriter.WriteLine($"Unknown excluded component '{component}'; Valid components are: {string.Join(", ", config.ComponentHeaders.Keys.Order())}.");
+                    retVal = false;
+                }
+            }
+
             // if HandleOutputPath is specified but does not exist, it is created so no need to test for that here
 
             return retVal;
@@ -122,6 +141,7 @@ namespace LlvmBindingsGenerator
                 .AppendLine(CultureInfo.InvariantCulture, $"    ExtensionsRoot: {ExtensionsRoot}")
                 .AppendLine(CultureInfo.InvariantCulture, $"    ConfigPathRoot: {ConfigPathRoot}")
                 .AppendLine(CultureInfo.InvariantCulture, $"ExportsDefFilePath: {ExportsDefFilePath}")
+                .AppendLine(CultureInfo.InvariantCulture, $"ExcludedComponents: {string.Join(';', ExcludedComponents)}")
                 .AppendLine(CultureInfo.InvariantCulture, $"       Diagnostics: {Diagnostics}");
             return bldr.ToString();
         }